@@ -2201,7 +2201,7 @@ bool Document::saveToFile(const char* filename) const
         writer.setLevel(compression);
         writer.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false)) {
+        if (hGrp->GetBool("SaveBinaryBrep", true)) {
             writer.setMode("BinaryBrep");
         }
 
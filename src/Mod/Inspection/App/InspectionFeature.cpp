@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
 #include <boost/core/ignore_unused.hpp>
 #include <numeric>
 
@@ -46,13 +47,14 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/FacetBVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Points/App/PointsFeature.h>
-#include <Mod/Points/App/PointsGrid.h>
+#include <Mod/Points/App/PointsOctree.h>
 
 #include "InspectionFeature.h"
 
@@ -281,36 +283,18 @@ private:
 }  // namespace Inspection
 
 InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset)
-    : _mesh(rMesh.getKernel())
 {
-    Base::Matrix4D tmp;
-    _clTrf = rMesh.getTransform();
-    _bApply = _clTrf != tmp;
-
-    // Max. limit of grid elements
-    float fMaxGridElements = 8000000.0f;
-    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
-
-    // estimate the minimum allowed grid length
-    float fMinGridLen =
-        (float)pow((box.LengthX() * box.LengthY() * box.LengthZ() / fMaxGridElements), 0.3333f);
-    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(_mesh).GetAverageEdgeLength();
-
-    // We want to avoid to get too small grid elements otherwise building up the grid structure
-    // would take too much time and memory. Having quite a dense grid speeds up more the following
-    // algorithms extremely. Due to the issue above it's always a compromise between speed and
-    // memory usage.
-    fGridLen = std::max<float>(fMinGridLen, fGridLen);
-
-    // build up grid structure to speed up algorithms
-    _pGrid = new MeshInspectGrid(_mesh, fGridLen, rMesh.getTransform());
-    _box = box;
+    // The bounding volume hierarchy adapts to the local density of the facets. So, unlike
+    // a grid it doesn't need a compromise between speed and memory usage for meshes that
+    // mix fine and coarse regions.
+    _pBVH = new MeshCore::MeshFacetBVH(rMesh.getKernel(), rMesh.getTransform());
+    _box = _pBVH->GetBoundBox();
     _box.Enlarge(offset);
 }
 
 InspectNominalMesh::~InspectNominalMesh()
 {
-    delete this->_pGrid;
+    delete this->_pBVH;
 }
 
 float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
@@ -319,29 +303,14 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
         return FLT_MAX;  // must be inside bbox
     }
 
-    std::vector<unsigned long> indices;
-    //_pGrid->GetElements(point, indices);
-    if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
-    }
-
     float fMinDist = FLT_MAX;
-    bool positive = true;
-    for (unsigned long it : indices) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
-        }
-
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
-        }
+    MeshCore::FacetIndex index = _pBVH->SearchNearestFromPoint(point, FLT_MAX, fMinDist);
+    if (index == MeshCore::FACET_INDEX_MAX) {
+        return FLT_MAX;
     }
 
+    MeshCore::MeshGeomFacet geomFace = _pBVH->GetFacet(index);
+    bool positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
     if (!positive) {
         fMinDist = -fMinDist;
     }
@@ -439,103 +408,127 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
 InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float /*offset*/)
     : _rKernel(Kernel)
 {
-    int uGridPerAxis = 50;  // totally 125.000 grid elements
-    this->_pGrid = new Points::PointsGrid(Kernel, uGridPerAxis);
+    // the octree works on the untransformed points
+    this->_pOctree = new Points::PointsOctree(Kernel);
+    this->_clInvTrf = Kernel.getTransform();
+    this->_clInvTrf.inverseGauss();
 }
 
 InspectNominalPoints::~InspectNominalPoints()
 {
-    delete this->_pGrid;
+    delete this->_pOctree;
 }
 
 float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 {
-    // TODO: Make faster
-    std::set<unsigned long> indices;
-    unsigned long x, y, z;
-    Base::Vector3d pointd(point.x, point.y, point.z);
-    _pGrid->Position(pointd, x, y, z);
-    _pGrid->GetElements(x, y, z, indices);
-
-    double fMinDist = DBL_MAX;
-    for (unsigned long it : indices) {
-        Base::Vector3d pt = _rKernel.getPoint(it);
-        double fDist = Base::Distance(pointd, pt);
-        if (fDist < fMinDist) {
-            fMinDist = fDist;
-        }
+    std::vector<unsigned long> indices;
+    std::vector<float> distances;
+    _pOctree->NearestNeighbours(_clInvTrf * point, 1, indices, distances);
+    if (distances.empty()) {
+        return FLT_MAX;
     }
 
-    return (float)fMinDist;
+    return distances.front();
 }
 
 // ----------------------------------------------------------------
 
+struct InspectNominalShape::Evaluator
+{
+    BRepExtrema_DistShapeShape distss;
+    BRepClass3d_SolidClassifier classifier;
+};
+
 InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
     : _rShape(shape)
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
-
     // When having a solid then use its shell because otherwise the distance
     // for inner points will always be zero
     if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
         TopExp_Explorer xp;
         xp.Init(_rShape, TopAbs_SHELL);
-        if (xp.More()) {
-            distss->LoadS1(xp.Current());
-            isSolid = true;
+        isSolid = xp.More();
+    }
+}
+
+InspectNominalShape::~InspectNominalShape() = default;
+
+std::unique_ptr<InspectNominalShape::Evaluator> InspectNominalShape::acquireEvaluator() const
+{
+    {
+        std::lock_guard<std::mutex> lock(evaluatorMutex);
+        if (!evaluators.empty()) {
+            std::unique_ptr<Evaluator> eval = std::move(evaluators.back());
+            evaluators.pop_back();
+            return eval;
         }
     }
-    // distss->SetDeflection(radius);
+
+    auto eval = std::make_unique<Evaluator>();
+    if (isSolid) {
+        TopExp_Explorer xp;
+        xp.Init(_rShape, TopAbs_SHELL);
+        eval->distss.LoadS1(xp.Current());
+        eval->classifier.Load(_rShape);
+    }
+    else {
+        eval->distss.LoadS1(_rShape);
+    }
+    return eval;
 }
 
-InspectNominalShape::~InspectNominalShape()
+void InspectNominalShape::releaseEvaluator(std::unique_ptr<Evaluator> eval) const
 {
-    delete distss;
+    std::lock_guard<std::mutex> lock(evaluatorMutex);
+    evaluators.push_back(std::move(eval));
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
+    std::unique_ptr<Evaluator> eval = acquireEvaluator();
+    BRepExtrema_DistShapeShape& distss = eval->distss;
+
     gp_Pnt pnt3d(point.x, point.y, point.z);
     BRepBuilderAPI_MakeVertex mkVert(pnt3d);
-    distss->LoadS2(mkVert.Vertex());
+    distss.LoadS2(mkVert.Vertex());
 
     float fMinDist = FLT_MAX;
-    if (distss->Perform() && distss->NbSolution() > 0) {
-        fMinDist = (float)distss->Value();
+    if (distss.Perform() && distss.NbSolution() > 0) {
+        fMinDist = (float)distss.Value();
         // the shape is a solid, check if the vertex is inside
         if (isSolid) {
-            if (isInsideSolid(pnt3d)) {
+            if (isInsideSolid(*eval, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
         else if (fMinDist > 0) {
             // check if the distance was computed from a face
-            if (isBelowFace(pnt3d)) {
+            if (isBelowFace(distss, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
     }
+
+    releaseEvaluator(std::move(eval));
     return fMinDist;
 }
 
-bool InspectNominalShape::isInsideSolid(const gp_Pnt& pnt3d) const
+bool InspectNominalShape::isInsideSolid(Evaluator& eval, const gp_Pnt& pnt3d) const
 {
     const Standard_Real tol = 0.001;
-    BRepClass3d_SolidClassifier classifier(_rShape);
-    classifier.Perform(pnt3d, tol);
-    return (classifier.State() == TopAbs_IN);
+    eval.classifier.Perform(pnt3d, tol);
+    return (eval.classifier.State() == TopAbs_IN);
 }
 
-bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
+bool InspectNominalShape::isBelowFace(const BRepExtrema_DistShapeShape& distss,
+                                      const gp_Pnt& pnt3d) const
 {
     // check if the distance was computed from a face
-    for (Standard_Integer index = 1; index <= distss->NbSolution(); index++) {
-        if (distss->SupportTypeShape1(index) == BRepExtrema_IsInFace) {
-            TopoDS_Shape face = distss->SupportOnShape1(index);
+    for (Standard_Integer index = 1; index <= distss.NbSolution(); index++) {
+        if (distss.SupportTypeShape1(index) == BRepExtrema_IsInFace) {
+            TopoDS_Shape face = distss.SupportOnShape1(index);
             Standard_Real u, v;
-            distss->ParOnFaceS1(index, u, v);
+            distss.ParOnFaceS1(index, u, v);
             // gp_Pnt pnt = distss->PointOnShape1(index);
             BRepGProp_Face props(TopoDS::Face(face));
             gp_Vec normal;
@@ -736,27 +729,163 @@ struct DistanceInspection
     std::vector<InspectNominalGeometry*> nominal;
 };
 
-// Helper internal class for QtConcurrent map operation. Holds sums-of-squares and counts for RMS
-// calculation
-class DistanceInspectionRMS
+// Helper internal class for QtConcurrent map operation. Collects the statistics of a block of
+// points, the results of all blocks are merged afterwards
+class DistanceInspectionStatistics
 {
 public:
-    DistanceInspectionRMS() = default;
-    DistanceInspectionRMS& operator+=(const DistanceInspectionRMS& rhs)
+    DistanceInspectionStatistics() = default;
+    DistanceInspectionStatistics(float radius,
+                                 float tolerance,
+                                 std::size_t numBins,
+                                 std::size_t numNominals)
+        : m_radius(radius)
+        , m_tolerance(tolerance)
+        , m_histogram(numBins, 0)
+        , m_nominalSumsq(numNominals, 0.0)
+        , m_nominalNumv(numNominals, 0)
+    {}
+    DistanceInspectionStatistics& operator+=(const DistanceInspectionStatistics& rhs)
     {
+        // the result of the reduction is default-constructed
+        if (m_histogram.empty() && m_nominalNumv.empty()) {
+            m_radius = rhs.m_radius;
+            m_tolerance = rhs.m_tolerance;
+            m_histogram.resize(rhs.m_histogram.size(), 0);
+            m_nominalSumsq.resize(rhs.m_nominalSumsq.size(), 0.0);
+            m_nominalNumv.resize(rhs.m_nominalNumv.size(), 0);
+        }
+
         this->m_numv += rhs.m_numv;
+        this->m_sum += rhs.m_sum;
         this->m_sumsq += rhs.m_sumsq;
+        this->m_min = std::min(this->m_min, rhs.m_min);
+        this->m_max = std::max(this->m_max, rhs.m_max);
+        this->m_inTolerance += rhs.m_inTolerance;
+        this->m_notFound += rhs.m_notFound;
+        for (std::size_t i = 0; i < m_histogram.size(); i++) {
+            m_histogram[i] += rhs.m_histogram[i];
+        }
+        for (std::size_t i = 0; i < m_nominalNumv.size(); i++) {
+            m_nominalSumsq[i] += rhs.m_nominalSumsq[i];
+            m_nominalNumv[i] += rhs.m_nominalNumv[i];
+        }
         return *this;
     }
-    double getRMS()
+    /// Adds the distance \a dist to the nominal with index \a nominal
+    void add(float dist, std::size_t nominal)
+    {
+        if (fabs(dist) > m_radius) {
+            m_notFound++;
+            return;
+        }
+
+        m_numv++;
+        m_sum += dist;
+        m_sumsq += double(dist) * dist;
+        m_min = std::min(m_min, dist);
+        m_max = std::max(m_max, dist);
+        if (fabs(dist) <= m_tolerance) {
+            m_inTolerance++;
+        }
+        if (!m_histogram.empty()) {
+            m_histogram[getBin(dist)]++;
+        }
+        if (nominal < m_nominalNumv.size()) {
+            m_nominalSumsq[nominal] += double(dist) * dist;
+            m_nominalNumv[nominal]++;
+        }
+    }
+    double getRMS() const
     {
         if (this->m_numv == 0) {
             return 0.0;
         }
         return sqrt(this->m_sumsq / (double)this->m_numv);
     }
-    int m_numv {0};
+    double getMean() const
+    {
+        if (this->m_numv == 0) {
+            return 0.0;
+        }
+        return this->m_sum / (double)this->m_numv;
+    }
+    double getMinimum() const
+    {
+        return this->m_numv > 0 ? this->m_min : 0.0;
+    }
+    double getMaximum() const
+    {
+        return this->m_numv > 0 ? this->m_max : 0.0;
+    }
+    double getNominalRMS(std::size_t nominal) const
+    {
+        if (m_nominalNumv[nominal] == 0) {
+            return 0.0;
+        }
+        return sqrt(m_nominalSumsq[nominal] / (double)m_nominalNumv[nominal]);
+    }
+    /// Interpolates the percentile \a level in the range [0, 100] from the histogram
+    double getPercentile(double level) const
+    {
+        if (this->m_numv == 0 || m_histogram.empty()) {
+            return 0.0;
+        }
+
+        double width = 2.0 * m_radius / double(m_histogram.size());
+        double target = std::clamp(level, 0.0, 100.0) / 100.0 * double(m_numv);
+        double count = 0.0;
+        for (std::size_t i = 0; i < m_histogram.size(); i++) {
+            double next = count + double(m_histogram[i]);
+            if (m_histogram[i] > 0 && next >= target) {
+                double value = -m_radius + width * (double(i) + (target - count) / m_histogram[i]);
+                return std::clamp(value, double(m_min), double(m_max));
+            }
+            count = next;
+        }
+        return m_max;
+    }
+    std::size_t getInTolerance() const
+    {
+        return m_inTolerance;
+    }
+    std::size_t getOutOfTolerance() const
+    {
+        return m_numv - m_inTolerance;
+    }
+    std::size_t getNotFound() const
+    {
+        return m_notFound;
+    }
+    const std::vector<std::size_t>& getHistogram() const
+    {
+        return m_histogram;
+    }
+
+private:
+    std::size_t getBin(float dist) const
+    {
+        auto numBins = m_histogram.size();
+        if (m_radius <= 0.0F) {
+            return 0;
+        }
+        auto bin = static_cast<std::size_t>((dist + m_radius) / (2.0F * m_radius) * numBins);
+        return std::min(bin, numBins - 1);
+    }
+
+private:
+    float m_radius {0.0F};
+    float m_tolerance {0.0F};
+    std::size_t m_numv {0};
+    double m_sum {0.0};
     double m_sumsq {0.0};
+    float m_min {FLT_MAX};
+    float m_max {-FLT_MAX};
+    std::size_t m_inTolerance {0};
+    std::size_t m_notFound {0};
+    std::vector<std::size_t> m_histogram;
+    std::vector<double> m_nominalSumsq;
+    std::vector<std::size_t> m_nominalNumv;
 };
 }  // namespace Inspection
 
@@ -769,6 +898,44 @@ Feature::Feature()
     ADD_PROPERTY(Actual, (nullptr));
     ADD_PROPERTY(Nominals, (nullptr));
     ADD_PROPERTY(Distances, (0.0));
+
+    static const char* group = "Statistics";
+    const auto output = App::PropertyType(App::Prop_ReadOnly | App::Prop_Output);
+    ADD_PROPERTY_TYPE(StoreDistances,
+                      (true),
+                      group,
+                      App::Prop_None,
+                      "Store the distance of every point, not needed for the statistics");
+    ADD_PROPERTY_TYPE(Tolerance, (0.01), group, App::Prop_None, "Tolerance of the distances");
+    ADD_PROPERTY_TYPE(HistogramBins,
+                      (20),
+                      group,
+                      App::Prop_None,
+                      "Number of histogram bins within the search radius");
+    ADD_PROPERTY_TYPE(PercentileLevels,
+                      (0.0),
+                      group,
+                      App::Prop_None,
+                      "Levels in the range [0, 100] of the computed percentiles");
+    PercentileLevels.setValues({5.0, 50.0, 95.0});
+    ADD_PROPERTY_TYPE(RMS, (0.0), group, output, "Root mean square of all found distances");
+    ADD_PROPERTY_TYPE(Mean, (0.0), group, output, "Mean of all found distances");
+    ADD_PROPERTY_TYPE(Minimum, (0.0), group, output, "Minimum of all found distances");
+    ADD_PROPERTY_TYPE(Maximum, (0.0), group, output, "Maximum of all found distances");
+    ADD_PROPERTY_TYPE(InTolerance, (0), group, output, "Number of points within the tolerance");
+    ADD_PROPERTY_TYPE(OutOfTolerance,
+                      (0),
+                      group,
+                      output,
+                      "Number of points outside the tolerance but within the search radius");
+    ADD_PROPERTY_TYPE(NotFound, (0), group, output, "Number of points outside the search radius");
+    ADD_PROPERTY_TYPE(Histogram, (0), group, output, "Number of found distances per bin");
+    ADD_PROPERTY_TYPE(Percentiles, (0.0), group, output, "Percentiles of the found distances");
+    ADD_PROPERTY_TYPE(NominalRMS,
+                      (0.0),
+                      group,
+                      output,
+                      "Root mean square of the distances per nominal geometry");
 }
 
 Feature::~Feature() = default;
@@ -787,13 +954,15 @@ short Feature::mustExecute() const
     if (Nominals.isTouched()) {
         return 1;
     }
+    if (StoreDistances.isTouched() || Tolerance.isTouched() || HistogramBins.isTouched()
+        || PercentileLevels.isTouched()) {
+        return 1;
+    }
     return 0;
 }
 
 App::DocumentObjectExecReturn* Feature::execute()
 {
-    bool useMultithreading = true;
-
     App::DocumentObject* pcActual = Actual.getValue();
     if (!pcActual) {
         throw Base::ValueError("No actual geometry to inspect specified");
@@ -809,7 +978,6 @@ App::DocumentObjectExecReturn* Feature::execute()
         actual = new InspectActualPoints(pts->Points.getValue());
     }
     else if (pcActual->isDerivedFrom<Part::Feature>()) {
-        useMultithreading = false;
         Part::Feature* part = static_cast<Part::Feature*>(pcActual);
         actual = new InspectActualShape(part->Shape.getShape());
     }
@@ -832,7 +1000,6 @@ App::DocumentObjectExecReturn* Feature::execute()
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(it);
             nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
         }
@@ -899,70 +1066,72 @@ App::DocumentObjectExecReturn* Feature::execute()
         this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), fRMS);
 #else
     unsigned long count = actual->countPoints();
-    std::vector<float> vals(count);
-    std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index) {
-        DistanceInspectionRMS res;
-        Base::Vector3f pnt = actual->getPoint(index);
-
-        float fMinDist = FLT_MAX;
-        for (auto it : inspectNominal) {
-            float fDist = it->getDistance(pnt);
-            if (fabs(fDist) < fabs(fMinDist)) {
-                fMinDist = fDist;
-            }
-        }
+    bool storeDistances = StoreDistances.getValue();
+    std::vector<float> vals(storeDistances ? count : 0);
+    auto radius = static_cast<float>(this->SearchRadius.getValue());
+    auto tolerance = static_cast<float>(this->Tolerance.getValue());
+    auto numBins = static_cast<std::size_t>(std::max<long>(HistogramBins.getValue(), 1));
+
+    // The points are processed in blocks and the statistics of each block are merged, so there
+    // is no need to keep the distances if they aren't stored
+    std::function<DistanceInspectionStatistics(const std::pair<unsigned long, unsigned long>&)>
+        fMap = [&](const std::pair<unsigned long, unsigned long>& block) {
+            DistanceInspectionStatistics res(radius, tolerance, numBins, inspectNominal.size());
+            for (unsigned long index = block.first; index < block.second; index++) {
+                Base::Vector3f pnt = actual->getPoint(index);
+
+                float fMinDist = FLT_MAX;
+                std::size_t nominal = 0;
+                for (std::size_t i = 0; i < inspectNominal.size(); i++) {
+                    float fDist = inspectNominal[i]->getDistance(pnt);
+                    if (fabs(fDist) < fabs(fMinDist)) {
+                        fMinDist = fDist;
+                        nominal = i;
+                    }
+                }
 
-        if (fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = FLT_MAX;
-        }
-        else if (-fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = -FLT_MAX;
-        }
-        else {
-            res.m_sumsq += fMinDist * fMinDist;
-            res.m_numv++;
-        }
+                res.add(fMinDist, nominal);
+                if (fMinDist > radius) {
+                    fMinDist = FLT_MAX;
+                }
+                else if (-fMinDist > radius) {
+                    fMinDist = -FLT_MAX;
+                }
 
-        vals[index] = fMinDist;
-        return res;
-    };
-
-    DistanceInspectionRMS res;
-
-    if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS
-        // computation
-        QFuture<DistanceInspectionRMS> future =
-            QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
-        // Setup progress bar
-        Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
-        QFutureWatcher<DistanceInspectionRMS> watcher;
-        QObject::connect(&watcher,
-                         &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
-                         &progress,
-                         &Base::FutureWatcherProgress::progressValueChanged);
-        // Keep UI responsive during computation
-        QEventLoop loop;
-        QObject::connect(&watcher,
-                         &QFutureWatcher<DistanceInspectionRMS>::finished,
-                         &loop,
-                         &QEventLoop::quit);
-        watcher.setFuture(future);
-        loop.exec();
-        res = future.result();
+                if (storeDistances) {
+                    vals[index] = fMinDist;
+                }
+            }
+            return res;
+        };
+
+    // Build the blocks of point indices
+    const unsigned long blockSize = 1024;
+    std::vector<std::pair<unsigned long, unsigned long>> blocks;
+    for (unsigned long index = 0; index < count; index += blockSize) {
+        blocks.emplace_back(index, std::min(index + blockSize, count));
     }
-    else {
-        // Single-threaded operation
-        std::stringstream str;
-        str << "Inspecting " << this->Label.getValue() << "...";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
-
-        for (unsigned int i = 0; i < count; i++) {
-            res += fMap(i);
-        }
+    // Perform map-reduce operation : compute distances and update the statistics
+    QFuture<DistanceInspectionStatistics> future =
+        QtConcurrent::mappedReduced(blocks, fMap, &DistanceInspectionStatistics::operator+=);
+    // Setup progress bar
+    Base::FutureWatcherProgress progress("Inspecting...", blocks.size());
+    QFutureWatcher<DistanceInspectionStatistics> watcher;
+    QObject::connect(&watcher,
+                     &QFutureWatcher<DistanceInspectionStatistics>::progressValueChanged,
+                     &progress,
+                     &Base::FutureWatcherProgress::progressValueChanged);
+    // Keep UI responsive during computation
+    QEventLoop loop;
+    QObject::connect(&watcher,
+                     &QFutureWatcher<DistanceInspectionStatistics>::finished,
+                     &loop,
+                     &QEventLoop::quit);
+    watcher.setFuture(future);
+    loop.exec();
+    DistanceInspectionStatistics res(radius, tolerance, numBins, inspectNominal.size());
+    if (!blocks.empty()) {
+        res = future.result();
     }
 
     Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
@@ -971,6 +1140,29 @@ App::DocumentObjectExecReturn* Feature::execute()
                             this->SearchRadius.getValue(),
                             res.getRMS());
     Distances.setValues(vals);
+
+    RMS.setValue(res.getRMS());
+    Mean.setValue(res.getMean());
+    Minimum.setValue(res.getMinimum());
+    Maximum.setValue(res.getMaximum());
+    InTolerance.setValue(static_cast<long>(res.getInTolerance()));
+    OutOfTolerance.setValue(static_cast<long>(res.getOutOfTolerance()));
+    NotFound.setValue(static_cast<long>(res.getNotFound()));
+
+    std::vector<long> histogram(res.getHistogram().begin(), res.getHistogram().end());
+    Histogram.setValues(histogram);
+
+    std::vector<double> percentiles;
+    for (double level : PercentileLevels.getValues()) {
+        percentiles.push_back(res.getPercentile(level));
+    }
+    Percentiles.setValues(percentiles);
+
+    std::vector<double> nominalRMS;
+    for (std::size_t i = 0; i < inspectNominal.size(); i++) {
+        nominalRMS.push_back(res.getNominalRMS(i));
+    }
+    NominalRMS.setValues(nominalRMS);
 #endif
 
     delete actual;
@@ -23,6 +23,10 @@
 #ifndef INSPECTION_FEATURE_H
 #define INSPECTION_FEATURE_H
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
@@ -38,6 +42,7 @@ namespace MeshCore
 {
 class MeshKernel;
 class MeshGrid;
+class MeshFacetBVH;
 }  // namespace MeshCore
 
 namespace Mesh
@@ -46,7 +51,7 @@ class MeshObject;
 }
 namespace Points
 {
-class PointsGrid;
+class PointsOctree;
 }
 namespace Part
 {
@@ -124,11 +129,8 @@ public:
     float getDistance(const Base::Vector3f&) const override;
 
 private:
-    const MeshCore::MeshKernel& _mesh;
-    MeshCore::MeshGrid* _pGrid;
+    MeshCore::MeshFacetBVH* _pBVH;
     Base::BoundBox3f _box;
-    bool _bApply;
-    Base::Matrix4D _clTrf;
 };
 
 class InspectionExport InspectNominalFastMesh: public InspectNominalGeometry
@@ -156,9 +158,13 @@ public:
 
 private:
     const Points::PointKernel& _rKernel;
-    Points::PointsGrid* _pGrid;
+    Points::PointsOctree* _pOctree;
+    Base::Matrix4D _clInvTrf;
 };
 
+/** The distance computation can be called from several threads at the same time. As the OCC
+ * algorithms keep their state each thread gets its own instances from a pool.
+ */
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
 {
 public:
@@ -167,13 +173,17 @@ public:
     float getDistance(const Base::Vector3f&) const override;
 
 private:
-    bool isInsideSolid(const gp_Pnt&) const;
-    bool isBelowFace(const gp_Pnt&) const;
+    struct Evaluator;
+    std::unique_ptr<Evaluator> acquireEvaluator() const;
+    void releaseEvaluator(std::unique_ptr<Evaluator>) const;
+    bool isInsideSolid(Evaluator&, const gp_Pnt&) const;
+    bool isBelowFace(const BRepExtrema_DistShapeShape&, const gp_Pnt&) const;
 
 private:
-    BRepExtrema_DistShapeShape* distss;
     const TopoDS_Shape& _rShape;
     bool isSolid {false};
+    mutable std::mutex evaluatorMutex;
+    mutable std::vector<std::unique_ptr<Evaluator>> evaluators;
 };
 
 class InspectionExport PropertyDistanceList: public App::PropertyLists
@@ -257,6 +267,28 @@ public:
     PropertyDistanceList Distances;
     //@}
 
+    /** @name Statistics
+     * The statistics are collected during the inspection. Distances within the search radius are
+     * counted as found, the ones within the tolerance as in tolerance. The histogram covers the
+     * range of the search radius and the percentiles are interpolated from it.
+     */
+    //@{
+    App::PropertyBool StoreDistances;
+    App::PropertyFloat Tolerance;
+    App::PropertyInteger HistogramBins;
+    App::PropertyFloatList PercentileLevels;
+    App::PropertyFloat RMS;
+    App::PropertyFloat Mean;
+    App::PropertyFloat Minimum;
+    App::PropertyFloat Maximum;
+    App::PropertyInteger InTolerance;
+    App::PropertyInteger OutOfTolerance;
+    App::PropertyInteger NotFound;
+    App::PropertyIntegerList Histogram;
+    App::PropertyFloatList Percentiles;
+    App::PropertyFloatList NominalRMS;
+    //@}
+
     /** @name Actions */
     //@{
     short mustExecute() const override;
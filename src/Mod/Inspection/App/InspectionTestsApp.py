@@ -0,0 +1,118 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+# ***************************************************************************
+# *                                                                         *
+# *   This file is part of FreeCAD.                                         *
+# *                                                                         *
+# *   FreeCAD is free software: you can redistribute it and/or modify it    *
+# *   under the terms of the GNU Lesser General Public License as           *
+# *   published by the Free Software Foundation, either version 2.1 of the  *
+# *   License, or (at your option) any later version.                       *
+# *                                                                         *
+# *   FreeCAD is distributed in the hope that it will be useful, but        *
+# *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+# *   Lesser General Public License for more details.                       *
+# *                                                                         *
+# *   You should have received a copy of the GNU Lesser General Public      *
+# *   License along with FreeCAD. If not, see                               *
+# *   <https://www.gnu.org/licenses/>.                                      *
+# *                                                                         *
+# ***************************************************************************
+
+import unittest
+import FreeCAD
+import Inspection
+import Points
+
+
+class InspectionStatisticsCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("InspectionTest")
+        nominal = self.doc.addObject("Points::Feature", "Nominal")
+        nominal.Points = Points.Points([FreeCAD.Vector(0, 0, 0)])
+        # Points at distances of 0, 0.005, 0.02 and 0.04 and one outside the search radius
+        actual = self.doc.addObject("Points::Feature", "Actual")
+        actual.Points = Points.Points(
+            [
+                FreeCAD.Vector(0.0, 0, 0),
+                FreeCAD.Vector(0.005, 0, 0),
+                FreeCAD.Vector(0.02, 0, 0),
+                FreeCAD.Vector(0.04, 0, 0),
+                FreeCAD.Vector(1.0, 0, 0),
+            ]
+        )
+        self.inspection = self.doc.addObject("Inspection::Feature", "Inspection")
+        self.inspection.Actual = actual
+        self.inspection.Nominals = [nominal]
+        self.inspection.SearchRadius = 0.05
+        self.inspection.Tolerance = 0.01
+        self.inspection.HistogramBins = 10
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.doc.Name)
+
+    def checkStatistics(self):
+        insp = self.inspection
+        self.assertEqual(insp.InTolerance, 2)
+        self.assertEqual(insp.OutOfTolerance, 2)
+        self.assertEqual(insp.NotFound, 1)
+        self.assertAlmostEqual(insp.Minimum, 0.0, places=5)
+        self.assertAlmostEqual(insp.Maximum, 0.04, places=5)
+        self.assertAlmostEqual(insp.Mean, 0.01625, places=5)
+        self.assertAlmostEqual(insp.RMS, 0.0225, places=5)
+        self.assertEqual(len(insp.NominalRMS), 1)
+        self.assertAlmostEqual(insp.NominalRMS[0], 0.0225, places=5)
+        self.assertEqual(len(insp.Histogram), 10)
+        self.assertEqual(sum(insp.Histogram), 4)
+        # The bins have a width of 0.01. The bin [0, 0.01) holds two distances, so the 5th
+        # and the 50th percentile are interpolated inside it, and the 95th is clamped to the
+        # maximum.
+        self.assertEqual(len(insp.Percentiles), 3)
+        self.assertAlmostEqual(insp.Percentiles[0], 0.001, places=5)
+        self.assertAlmostEqual(insp.Percentiles[1], 0.01, places=5)
+        self.assertAlmostEqual(insp.Percentiles[2], 0.04, places=5)
+
+    def testStatistics(self):
+        self.doc.recompute()
+        self.checkStatistics()
+        self.assertEqual(len(self.inspection.Distances), 5)
+        self.assertAlmostEqual(self.inspection.Distances[2], 0.02, places=5)
+
+    def testWithoutDistances(self):
+        self.inspection.StoreDistances = False
+        self.doc.recompute()
+        self.checkStatistics()
+        self.assertEqual(len(self.inspection.Distances), 0)
+
+
+class InspectionPercentileCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("InspectionTest")
+        nominal = self.doc.addObject("Points::Feature", "Nominal")
+        nominal.Points = Points.Points([FreeCAD.Vector(0, 0, 0)])
+        # Ten points at distances of 0.05, 0.15, ..., 0.95. With a search radius of 1 the
+        # ten bins have a width of 0.2, so the bins of the positive half hold two points each.
+        actual = self.doc.addObject("Points::Feature", "Actual")
+        actual.Points = Points.Points([FreeCAD.Vector(0.05 + 0.1 * i, 0, 0) for i in range(10)])
+        self.inspection = self.doc.addObject("Inspection::Feature", "Inspection")
+        self.inspection.Actual = actual
+        self.inspection.Nominals = [nominal]
+        self.inspection.SearchRadius = 1.0
+        self.inspection.Tolerance = 0.1
+        self.inspection.HistogramBins = 10
+        self.inspection.PercentileLevels = [0.0, 10.0, 50.0, 90.0, 100.0]
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.doc.Name)
+
+    def testPercentiles(self):
+        self.doc.recompute()
+        insp = self.inspection
+        self.assertEqual(list(insp.Histogram), [0, 0, 0, 0, 0, 2, 2, 2, 2, 2])
+        # The 10th percentile is the middle of the bin [0, 0.2), the median the middle of
+        # [0.4, 0.6) and the 90th percentile the middle of [0.8, 1.0). The 0th and 100th
+        # percentile are clamped to the minimum and maximum.
+        expected = [0.05, 0.1, 0.5, 0.9, 0.95]
+        self.assertEqual(len(insp.Percentiles), len(expected))
+        for value, percentile in zip(expected, insp.Percentiles):
+            self.assertAlmostEqual(percentile, value, places=5)
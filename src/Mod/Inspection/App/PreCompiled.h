@@ -35,6 +35,7 @@
 #ifdef _PreComp_
 
 // STL
+#include <algorithm>
 #include <numeric>
 
 // OCC
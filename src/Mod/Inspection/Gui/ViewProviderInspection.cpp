@@ -671,6 +671,14 @@ QString ViewProviderInspection::inspectDistance(const SoPickedPoint* pp) const
             int index1 = facedetail->getPoint(0)->getCoordinateIndex();
             int index2 = facedetail->getPoint(1)->getCoordinateIndex();
             int index3 = facedetail->getPoint(2)->getCoordinateIndex();
+            // the list is empty if the feature doesn't store the distances
+            int numValues = dist->getSize();
+            auto isValid = [numValues](int index) {
+                return index >= 0 && index < numValues;
+            };
+            if (!isValid(index1) || !isValid(index2) || !isValid(index3)) {
+                return QObject::tr("No distance available");
+            }
             float fVal1 = (*dist)[index1];
             float fVal2 = (*dist)[index2];
             float fVal3 = (*dist)[index3];
@@ -719,6 +727,9 @@ QString ViewProviderInspection::inspectDistance(const SoPickedPoint* pp) const
         if (prop && prop->is<Inspection::PropertyDistanceList>()) {
             Inspection::PropertyDistanceList* dist =
                 static_cast<Inspection::PropertyDistanceList*>(prop);
+            if (index < 0 || index >= dist->getSize()) {
+                return QObject::tr("No distance available");
+            }
             float fVal = (*dist)[index];
             info = QObject::tr("Distance: %1").arg(fVal);
         }
@@ -22,3 +22,7 @@
 # ***************************************************************************/
 
 # FreeCAD init script of the Inspection module
+
+import FreeCAD
+
+FreeCAD.__unit_test__ += ["InspectionTestsApp"]
@@ -1920,6 +1920,45 @@ void MeshRefPointToFacets::Neighbours(FacetIndex ulFacetInd,
     SearchNeighbours(rFacets, ulFacetInd, clCenter, fMaxDist * fMaxDist, visited, collect);
 }
 
+void MeshRefPointToFacets::Neighbours(FacetIndex ulFacetInd,
+                                      float fMaxDist,
+                                      MeshCollector& collect,
+                                      MeshFlagSet& visited) const
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    Base::Vector3f clCenter = _rclMesh.GetFacet(ulFacetInd).GetGravityPoint();
+    float fMaxDist2 = fMaxDist * fMaxDist;
+
+    std::vector<FacetIndex> touched;
+    std::vector<FacetIndex> stack;
+    stack.push_back(ulFacetInd);
+    visited.Set(ulFacetInd);
+    touched.push_back(ulFacetInd);
+
+    while (!stack.empty()) {
+        FacetIndex index = stack.back();
+        stack.pop_back();
+
+        const MeshFacet& face = rFacets[index];
+        if (Base::DistanceP2(clCenter, _rclMesh.GetFacet(face).GetGravityPoint()) > fMaxDist2) {
+            continue;
+        }
+
+        collect.Append(_rclMesh, index);
+        for (PointIndex ptIndex : face._aulPoints) {
+            for (FacetIndex j : _map[ptIndex]) {
+                if (!visited.IsSet(j)) {
+                    visited.Set(j);
+                    touched.push_back(j);
+                    stack.push_back(j);
+                }
+            }
+        }
+    }
+
+    visited.Reset(touched);
+}
+
 void MeshRefPointToFacets::SearchNeighbours(const MeshFacetArray& rFacets,
                                             FacetIndex index,
                                             const Base::Vector3f& rclCenter,
@@ -490,6 +490,14 @@ public:
     std::set<PointIndex> NeighbourPoints(const std::vector<PointIndex>&, int level) const;
     std::set<PointIndex> NeighbourPoints(PointIndex) const;
     void Neighbours(FacetIndex ulFacetInd, float fMaxDist, MeshCollector& collect) const;
+    /** Does the same as the method above but marks the visited facets in \a visited instead of
+     * a std::set. The flags are reset before returning so that the same flag set can be reused
+     * for the next search. When searching concurrently each thread needs its own flag set.
+     */
+    void Neighbours(FacetIndex ulFacetInd,
+                    float fMaxDist,
+                    MeshCollector& collect,
+                    MeshFlagSet& visited) const;
     Base::Vector3f GetNormal(PointIndex) const;
     void AddNeighbour(PointIndex, FacetIndex);
     void RemoveNeighbour(PointIndex, FacetIndex);
@@ -358,6 +358,21 @@ void MeshFastBuilder::AddFacet(const MeshGeomFacet& facetPoints)
     }
 }
 
+void MeshFastBuilder::Resize(size_type ctFacets)
+{
+    p->verts.resize(ctFacets * 3);
+}
+
+void MeshFastBuilder::SetFacet(size_type index, const Base::Vector3f* facetPoints)
+{
+    Private::Vertex* v = p->verts.data() + 3 * index;
+    for (int i = 0; i < 3; i++, v++) {
+        v->x = facetPoints[i].x;
+        v->y = facetPoints[i].y;
+        v->z = facetPoints[i].z;
+    }
+}
+
 void MeshFastBuilder::Finish()
 {
     using size_type = QVector<Private::Vertex>::size_type;
@@ -390,13 +405,17 @@ void MeshFastBuilder::Finish()
         rFacets[static_cast<size_t>(i)]._aulPoints[2] = indices[3 * i + 2];
     }
 
-    verts.resize(vertex_count);
+    // release the memory as early as possible to keep the peak low for large meshes
+    indices = QVector<FacetIndex>();
 
     MeshPointArray rPoints;
     rPoints.reserve(static_cast<size_t>(vertex_count));
-    for (const auto& v : verts) {
+    for (size_type i = 0; i < vertex_count; ++i) {
+        const Private::Vertex& v = verts[i];
         rPoints.push_back(MeshPoint(v.x, v.y, v.z));
     }
 
+    verts = QVector<Private::Vertex>();
+
     _meshKernel.Adopt(rPoints, rFacets, true);
 }
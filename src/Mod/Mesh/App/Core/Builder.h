@@ -218,6 +218,12 @@ public:
     /** Add new facet
      */
     void AddFacet(const MeshGeomFacet& facetPoints);
+    /** Resizes the facet storage to \a ctFacets facets that must then be set with SetFacet().
+     */
+    void Resize(size_type ctFacets);
+    /** Sets the points of the facet at \a index. Different facets can be set concurrently.
+     */
+    void SetFacet(size_type index, const Base::Vector3f* facetPoints);
 
     /** Finishes building up the mesh structure. Must be done after adding facets.
      */
@@ -24,10 +24,9 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <functional>
+#include <thread>
 #endif
 
-#include <QFuture>
-#include <QFutureWatcher>
 #include <QtConcurrentMap>
 
 #include <Base/Sequencer.h>
@@ -50,6 +49,26 @@
 using namespace MeshCore;
 namespace sp = std::placeholders;
 
+namespace
+{
+struct CurvatureRange
+{
+    std::size_t begin;
+    std::size_t end;
+    MeshFlagSet* visited;
+};
+
+void computeRange(const FacetCurvature& face,
+                  const std::vector<FacetIndex>& segment,
+                  std::vector<CurvatureInfo>& curvature,
+                  const CurvatureRange& range)
+{
+    for (std::size_t i = range.begin; i < range.end; i++) {
+        curvature[i] = face.Compute(segment[i], *range.visited);
+    }
+}
+}  // namespace
+
 MeshCurvature::MeshCurvature(const MeshKernel& kernel)
     : myKernel(kernel)
     , myMinPoints(20)
@@ -72,24 +91,48 @@ void MeshCurvature::ComputePerFace(bool parallel)
     MeshRefPointToFacets search(myKernel);
     FacetCurvature face(myKernel, search, myRadius, myMinPoints);
 
+    myCurvature.reserve(mySegment.size());
     if (!parallel) {
+        MeshFlagSet visited(myKernel.CountFacets());
         Base::SequencerLauncher seq("Curvature estimation", mySegment.size());
         for (FacetIndex it : mySegment) {
-            CurvatureInfo info = face.Compute(it);
+            CurvatureInfo info = face.Compute(it, visited);
             myCurvature.push_back(info);
             seq.next();
         }
     }
-    else {
-        // NOLINTBEGIN
-        QFuture<CurvatureInfo> future =
-            QtConcurrent::mapped(mySegment, std::bind(&FacetCurvature::Compute, &face, sp::_1));
-        // NOLINTEND
-        QFutureWatcher<CurvatureInfo> watcher;
-        watcher.setFuture(future);
-        watcher.waitForFinished();
-        for (const auto& it : future) {
-            myCurvature.push_back(it);
+    else if (!mySegment.empty()) {
+        // The facets are processed in chunks, so the progress can be reported. Each chunk is
+        // split into one range per thread and every range writes its results in place.
+        // The flag sets to collect the neighbourhoods are allocated once per thread and
+        // reused for all chunks.
+        const std::size_t numRanges = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        const std::size_t chunkSize = numRanges * 4096;
+        const std::size_t numChunks = (mySegment.size() + chunkSize - 1) / chunkSize;
+        std::vector<MeshFlagSet> visited(numRanges, MeshFlagSet(myKernel.CountFacets()));
+        myCurvature.resize(mySegment.size());
+
+        Base::SequencerLauncher seq("Curvature estimation", numChunks);
+        for (std::size_t first = 0; first < mySegment.size(); first += chunkSize) {
+            const std::size_t size = std::min(chunkSize, mySegment.size() - first);
+            std::vector<CurvatureRange> ranges;
+            ranges.reserve(numRanges);
+            for (std::size_t i = 0; i < numRanges; i++) {
+                ranges.push_back({first + i * size / numRanges,
+                                  first + (i + 1) * size / numRanges,
+                                  &visited[i]});
+            }
+
+            // NOLINTBEGIN
+            QtConcurrent::blockingMap(
+                ranges,
+                std::bind(&computeRange,
+                          std::cref(face),
+                          std::cref(mySegment),
+                          std::ref(myCurvature),
+                          sp::_1));
+            // NOLINTEND
+            seq.next();
         }
     }
 }
@@ -382,6 +425,20 @@ FacetCurvature::FacetCurvature(const MeshKernel& kernel,
 {}
 
 CurvatureInfo FacetCurvature::Compute(FacetIndex index) const
+{
+    return Compute(index, [this, index](float searchDist, MeshCollector& collect) {
+        mySearch.Neighbours(index, searchDist, collect);
+    });
+}
+
+CurvatureInfo FacetCurvature::Compute(FacetIndex index, MeshFlagSet& visited) const
+{
+    return Compute(index, [this, index, &visited](float searchDist, MeshCollector& collect) {
+        mySearch.Neighbours(index, searchDist, collect, visited);
+    });
+}
+
+CurvatureInfo FacetCurvature::Compute(FacetIndex index, const NeighbourSearch& search) const
 {
     Base::Vector3f rkDir0, rkDir1;
     Base::Vector3f rkNormal;
@@ -395,7 +452,7 @@ CurvatureInfo FacetCurvature::Compute(FacetIndex index) const
     float searchDist = myRadius;
     int attempts = 0;
     do {
-        mySearch.Neighbours(index, searchDist, collect);
+        search(searchDist, collect);
         if (point_indices.empty()) {
             break;
         }
@@ -25,11 +25,14 @@
 
 #include "Definitions.h"
 #include <Base/Vector3D.h>
+#include <functional>
 #include <vector>
 
 namespace MeshCore
 {
 
+class MeshCollector;
+class MeshFlagSet;
 class MeshKernel;
 class MeshRefPointToFacets;
 
@@ -48,6 +51,14 @@ public:
                    float,
                    unsigned long);
     CurvatureInfo Compute(FacetIndex index) const;
+    /** Does the same as the method above but uses \a visited to collect the neighbourhood
+     * of the facet. When computing concurrently each thread needs its own flag set.
+     */
+    CurvatureInfo Compute(FacetIndex index, MeshFlagSet& visited) const;
+
+private:
+    using NeighbourSearch = std::function<void(float, MeshCollector&)>;
+    CurvatureInfo Compute(FacetIndex index, const NeighbourSearch& search) const;
 
 private:
     const MeshKernel& myKernel;
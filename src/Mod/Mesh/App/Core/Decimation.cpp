@@ -22,51 +22,76 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+#include <algorithm>
+#include <cfloat>
+#include <thread>
+#include <vector>
+#endif
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
-MeshSimplify::MeshSimplify(MeshKernel& mesh)
-    : myKernel(mesh)
-{}
+namespace
+{
+// Number of facets per slab. It doesn't depend on the number of threads so that the
+// result is the same on every machine.
+constexpr std::size_t partitionSize = 100000;
 
-void MeshSimplify::simplify(float tolerance, float reduction)
+Simplify::Triangle makeTriangle(int v0, int v1, int v2)
 {
-    Simplify alg;
+    Simplify::Triangle t;
+    t.deleted = 0;
+    t.dirty = 0;
+    for (double& j : t.err) {
+        j = 0.0;
+    }
+    t.v[0] = v0;
+    t.v[1] = v1;
+    t.v[2] = v2;
+    return t;
+}
 
-    const MeshPointArray& points = myKernel.GetPoints();
+Simplify::Vertex makeVertex(const Base::Vector3f& p, int id, int locked)
+{
+    Simplify::Vertex v;
+    v.tstart = 0;
+    v.tcount = 0;
+    v.border = 0;
+    v.locked = locked;
+    v.id = id;
+    v.p = p;
+    return v;
+}
+
+void fillSimplify(Simplify& alg, const MeshKernel& kernel)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    alg.vertices.reserve(points.size());
     for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+        alg.vertices.push_back(makeVertex(points[i], static_cast<int>(i), 0));
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
-        }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
-        }
-        alg.triangles.push_back(t);
+    const MeshFacetArray& facets = kernel.GetFacets();
+    alg.triangles.reserve(facets.size());
+    for (const auto& facet : facets) {
+        alg.triangles.push_back(makeTriangle(static_cast<int>(facet._aulPoints[0]),
+                                             static_cast<int>(facet._aulPoints[1]),
+                                             static_cast<int>(facet._aulPoints[2])));
     }
+}
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
-
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
-
-    // Simplification done
+void adoptSimplify(const Simplify& alg, MeshKernel& kernel)
+{
     MeshPointArray new_points;
     new_points.reserve(alg.vertices.size());
     for (const auto& vertex : alg.vertices) {
@@ -91,64 +116,221 @@ void MeshSimplify::simplify(float tolerance, float reduction)
         }
     }
 
-    myKernel.Adopt(new_points, new_facets, true);
+    kernel.Adopt(new_points, new_facets, true);
+}
+
+// A slab of the mesh that is simplified independently of the others
+struct Partition
+{
+    Simplify alg;
+    int targetSize {0};
+    double tolerance {0.0};
+};
+
+void simplifyPartition(Partition& part)
+{
+    part.alg.simplify_mesh(part.targetSize, part.tolerance);
+}
+}  // namespace
+
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+    : myKernel(mesh)
+{}
+
+void MeshSimplify::simplify(float tolerance, float reduction)
+{
+    Simplify alg;
+    fillSimplify(alg, myKernel);
+
+    std::size_t numFacets = myKernel.CountFacets();
+    int target_count = static_cast<int>(static_cast<float>(numFacets) * (1.0F - reduction));
+
+    // Simplification starts
+    alg.simplify_mesh(target_count, tolerance);
+
+    // Simplification done
+    adoptSimplify(alg, myKernel);
 }
 
 void MeshSimplify::simplify(int targetSize)
 {
     Simplify alg;
+    fillSimplify(alg, myKernel);
+
+    // Simplification starts
+    alg.simplify_mesh(targetSize, FLT_MAX);
+
+    // Simplification done
+    adoptSimplify(alg, myKernel);
+}
 
+void MeshSimplify::simplifyParallel(int targetSize, float tolerance)
+{
     const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    const double maxError = tolerance > 0.0F ? tolerance : FLT_MAX;
+
+    const int numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const std::size_t numPartitions = facets.size() / partitionSize;
+    if (numPartitions < 2 || facets.size() <= static_cast<std::size_t>(std::max(targetSize, 0))) {
+        Simplify alg;
+        fillSimplify(alg, myKernel);
+        alg.simplify_mesh(targetSize, maxError);
+        adoptSimplify(alg, myKernel);
+        return;
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
-        }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
-        }
-        alg.triangles.push_back(t);
+    // Sort the facets along the longest side of the bounding box and cut them into
+    // slabs with the same number of facets. Ties are ordered by the facet index to get
+    // the same slabs independent of the sort algorithm.
+    Base::BoundBox3f bbox = myKernel.GetBoundBox();
+    unsigned short axis = 0;
+    if (bbox.LengthY() > bbox.LengthX()) {
+        axis = 1;
+    }
+    if (bbox.LengthZ() > std::max(bbox.LengthX(), bbox.LengthY())) {
+        axis = 2;
     }
 
-    // Simplification starts
-    alg.simplify_mesh(targetSize, FLT_MAX);
+    std::vector<std::pair<float, FacetIndex>> order;
+    order.reserve(facets.size());
+    for (FacetIndex i = 0; i < facets.size(); i++) {
+        const MeshFacet& face = facets[i];
+        float center = points[face._aulPoints[0]][axis] + points[face._aulPoints[1]][axis]
+            + points[face._aulPoints[2]][axis];
+        order.emplace_back(center, i);
+    }
+    MeshCore::parallel_sort(
+        order.begin(),
+        order.end(),
+        [](const auto& a, const auto& b) {
+            return a < b;
+        },
+        numThreads);
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
+    auto partitionBegin = [&](std::size_t k) {
+        return k * facets.size() / numPartitions;
+    };
+
+    // Vertices used by facets of different slabs lie on a seam and must be kept in place
+    const int onSeam = -2;
+    std::vector<int> vertexOwner(points.size(), -1);
+    for (std::size_t k = 0; k < numPartitions; k++) {
+        for (std::size_t i = partitionBegin(k); i < partitionBegin(k + 1); i++) {
+            for (PointIndex p : facets[order[i].second]._aulPoints) {
+                int& owner = vertexOwner[p];
+                if (owner == -1) {
+                    owner = static_cast<int>(k);
+                }
+                else if (owner != static_cast<int>(k)) {
+                    owner = onSeam;
+                }
+            }
+        }
     }
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
+    // Each slab gets a share of the target size plus its facets along the seams which
+    // cannot be removed in this step
+    std::vector<Partition> partitions(numPartitions);
+    std::vector<int> localIndex(points.size(), -1);
+    for (std::size_t k = 0; k < numPartitions; k++) {
+        Partition& part = partitions[k];
+        std::size_t begin = partitionBegin(k);
+        std::size_t end = partitionBegin(k + 1);
+        int seamFacets = 0;
+        part.alg.triangles.reserve(end - begin);
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& face = facets[order[i].second];
+            int v[3];
+            bool seam = false;
+            for (int j = 0; j < 3; j++) {
+                PointIndex p = face._aulPoints[j];
+                int locked = vertexOwner[p] == onSeam ? 1 : 0;
+                if (localIndex[p] < 0) {
+                    localIndex[p] = static_cast<int>(part.alg.vertices.size());
+                    part.alg.vertices.push_back(makeVertex(points[p], static_cast<int>(p), locked));
+                }
+                v[j] = localIndex[p];
+                seam = seam || locked;
+            }
+            if (seam) {
+                seamFacets++;
+            }
+            part.alg.triangles.push_back(makeTriangle(v[0], v[1], v[2]));
+        }
+
+        for (const auto& vertex : part.alg.vertices) {
+            localIndex[vertex.id] = -1;
         }
+
+        double share = static_cast<double>(end - begin) / static_cast<double>(facets.size());
+        part.targetSize = static_cast<int>(share * targetSize) + seamFacets;
+        part.tolerance = maxError;
     }
+
+    order.clear();
+    order.shrink_to_fit();
+
+    QFuture<void> future = QtConcurrent::map(partitions, &simplifyPartition);
+    QFutureWatcher<void> watcher;
+    watcher.setFuture(future);
+    watcher.waitForFinished();
+
+    // Stitch the slabs together again where the seam vertices are merged by their
+    // original index
+    MeshPointArray new_points;
     MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
+    std::vector<bool> seamPoints;
+    std::vector<PointIndex> seamIndex(points.size(), POINT_INDEX_MAX);
+    for (auto& part : partitions) {
+        std::vector<PointIndex> globalIndex(part.alg.vertices.size());
+        for (std::size_t i = 0; i < part.alg.vertices.size(); i++) {
+            const Simplify::Vertex& vertex = part.alg.vertices[i];
+            if (vertex.locked) {
+                PointIndex& index = seamIndex[vertex.id];
+                if (index == POINT_INDEX_MAX) {
+                    index = new_points.size();
+                    new_points.push_back(vertex.p);
+                    seamPoints.push_back(true);
+                }
+                globalIndex[i] = index;
+            }
+            else {
+                globalIndex[i] = new_points.size();
+                new_points.push_back(vertex.p);
+                seamPoints.push_back(false);
+            }
+        }
+
+        for (const auto& triangle : part.alg.triangles) {
+            new_facets.emplace_back(globalIndex[triangle.v[0]],
+                                    globalIndex[triangle.v[1]],
+                                    globalIndex[triangle.v[2]]);
         }
+
+        part.alg = Simplify();
     }
 
     myKernel.Adopt(new_points, new_facets, true);
+
+    // Finish the seams where only the seam vertices and their direct neighbours can be moved
+    if (myKernel.CountFacets() > static_cast<std::size_t>(std::max(targetSize, 0))) {
+        std::vector<bool> movable(seamPoints);
+        for (const auto& face : myKernel.GetFacets()) {
+            if (seamPoints[face._aulPoints[0]] || seamPoints[face._aulPoints[1]]
+                || seamPoints[face._aulPoints[2]]) {
+                movable[face._aulPoints[0]] = true;
+                movable[face._aulPoints[1]] = true;
+                movable[face._aulPoints[2]] = true;
+            }
+        }
+
+        Simplify alg;
+        fillSimplify(alg, myKernel);
+        for (std::size_t i = 0; i < alg.vertices.size(); i++) {
+            alg.vertices[i].locked = movable[i] ? 0 : 1;
+        }
+        alg.simplify_mesh(targetSize, maxError);
+        adoptSimplify(alg, myKernel);
+    }
 }
@@ -36,6 +36,15 @@ public:
     explicit MeshSimplify(MeshKernel&);
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /**
+     * Reduces the mesh to about \a targetSize facets like simplify(int) but splits a large
+     * mesh into slabs of a fixed size that are simplified concurrently. The vertices shared by
+     * two slabs are kept in place and the seams are simplified in a final pass over the
+     * stitched mesh. The result doesn't depend on the number of threads.
+     * If \a tolerance is > 0 it limits the quadratic error of a collapse. Small meshes are
+     * simplified in one piece.
+     */
+    void simplifyParallel(int targetSize, float tolerance = 0.0F);
 
 private:
     MeshKernel& myKernel;
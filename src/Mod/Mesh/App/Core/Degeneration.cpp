@@ -931,15 +931,23 @@ bool MeshEvalFoldsOnSurface::Evaluate()
 {
     this->indices.clear();
     const MeshFacetArray& rFAry = _rclMesh.GetFacets();
+
+    // compute every normal only once instead of for each neighbour relation
+    std::vector<Base::Vector3f> normals;
+    normals.reserve(rFAry.size());
+    for (const auto& it : rFAry) {
+        normals.push_back(_rclMesh.GetFacet(it).GetNormal());
+    }
+
     unsigned long ct = 0;
     for (auto it = rFAry.begin(); it != rFAry.end(); ++it, ct++) {
         for (int i = 0; i < 3; i++) {
             FacetIndex n1 = it->_aulNeighbours[i];
             FacetIndex n2 = it->_aulNeighbours[(i + 1) % 3];
-            Base::Vector3f v1 = _rclMesh.GetFacet(*it).GetNormal();
+            const Base::Vector3f& v1 = normals[ct];
             if (n1 != FACET_INDEX_MAX && n2 != FACET_INDEX_MAX) {
-                Base::Vector3f v2 = _rclMesh.GetFacet(n1).GetNormal();
-                Base::Vector3f v3 = _rclMesh.GetFacet(n2).GetNormal();
+                const Base::Vector3f& v2 = normals[n1];
+                const Base::Vector3f& v3 = normals[n2];
                 if (v2 * v3 > 0.0F) {
                     if (v1 * v2 < -0.1F && v1 * v3 < -0.1F) {
                         indices.push_back(n1);
@@ -1071,6 +1071,45 @@ bool MeshGeomFacet::IsCoplanar(const MeshGeomFacet& facet) const
     return (mult >= unit) && (dist <= eps);
 }
 
+int MeshGeomFacet::IntersectWithCoplanarFacet(const MeshGeomFacet& rclFacet,
+                                              Base::Vector3f& rclPt0,
+                                              Base::Vector3f& rclPt1) const
+{
+    std::vector<Base::Vector3f> intersections;
+    for (short i = 0; i < 3; i++) {
+        MeshGeomEdge edge1 = GetEdge(i);
+        for (short j = 0; j < 3; j++) {
+            MeshGeomEdge edge2 = rclFacet.GetEdge(j);
+            Base::Vector3f point;
+            if (edge1.IntersectWithEdge(edge2, point)) {
+                intersections.push_back(point);
+            }
+        }
+    }
+
+    if (intersections.empty()) {
+        return 0;
+    }
+
+    // If triangles overlap there can be more than two intersection points.
+    // The two points farthest apart are the extreme points along the line through them.
+    rclPt0 = intersections[0];
+    rclPt1 = intersections[0];
+    float maxDist = 0.0F;
+    for (std::size_t i = 0; i < intersections.size(); i++) {
+        for (std::size_t j = i + 1; j < intersections.size(); j++) {
+            float dist = Base::DistanceP2(intersections[i], intersections[j]);
+            if (dist > maxDist) {
+                maxDist = dist;
+                rclPt0 = intersections[i];
+                rclPt1 = intersections[j];
+            }
+        }
+    }
+
+    return maxDist > 0.0F ? 2 : 1;
+}
+
 /**
  * Fast Triangle-Triangle Intersection Test by Tomas Moeller
  * http://www.acm.org/jgt/papers/Moller97/tritri.html
@@ -569,6 +569,15 @@ public:
     int IntersectWithFacet(const MeshGeomFacet& facet,
                            Base::Vector3f& rclPt0,
                            Base::Vector3f& rclPt1) const;
+    /**
+     * Intersect the facet with the other facet that lies in the same plane. The result is the
+     * line between the extreme points of the edge/edge intersections along the line through
+     * them. Return is the number of intersections points: 0: no intersection, 1: one
+     * intersection point (rclPt0), 2: two intersections points (rclPt0, rclPt1)
+     */
+    int IntersectWithCoplanarFacet(const MeshGeomFacet& facet,
+                                   Base::Vector3f& rclPt0,
+                                   Base::Vector3f& rclPt1) const;
     /** Calculates the shortest distance from the line segment defined by \a rcP1 and \a rcP2 to
      * this facet.
      */
@@ -677,6 +686,87 @@ public:
                                   // NOLINTEND
 };
 
+/**
+ * The MeshFlagSet class holds one flag per point or facet outside of the mesh data structure.
+ * Unlike the flags of MeshPoint and MeshFacet it is owned by the algorithm that uses it, so the
+ * mesh isn't modified and several algorithms can work on the same mesh at the same time.
+ * It needs one bit per element instead of the flag member of each element.
+ */
+class MeshExport MeshFlagSet
+{
+public:
+    explicit MeshFlagSet(ElementIndex ulSize = 0, bool value = false)
+        : _bits(ulSize, value)
+    {}
+    /** Resizes the set, new elements are initialized with \a value. */
+    void Resize(ElementIndex ulSize, bool value = false)
+    {
+        _bits.resize(ulSize, value);
+    }
+    ElementIndex Size() const
+    {
+        return _bits.size();
+    }
+    void Set(ElementIndex ulIndex)
+    {
+        _bits[ulIndex] = true;
+    }
+    void Reset(ElementIndex ulIndex)
+    {
+        _bits[ulIndex] = false;
+    }
+    bool IsSet(ElementIndex ulIndex) const
+    {
+        return _bits[ulIndex];
+    }
+    /** Sets or resets the flags of all elements. */
+    void Assign(bool value)
+    {
+        _bits.assign(_bits.size(), value);
+    }
+    /** Sets the flags of the given elements. */
+    void Set(const std::vector<ElementIndex>& raulInds)
+    {
+        for (ElementIndex it : raulInds) {
+            _bits[it] = true;
+        }
+    }
+    /** Resets the flags of the given elements. */
+    void Reset(const std::vector<ElementIndex>& raulInds)
+    {
+        for (ElementIndex it : raulInds) {
+            _bits[it] = false;
+        }
+    }
+    /** Returns the number of set flags. */
+    ElementIndex Count() const
+    {
+        ElementIndex count = 0;
+        for (bool bit : _bits) {
+            if (bit) {
+                count++;
+            }
+        }
+        return count;
+    }
+    /**
+     * Returns the index of the first element from \a ulStart on whose flag is not set,
+     * or ELEMENT_INDEX_MAX if there is none.
+     */
+    ElementIndex FindFirstUnset(ElementIndex ulStart = 0) const
+    {
+        for (ElementIndex i = ulStart; i < _bits.size(); i++) {
+            if (!_bits[i]) {
+                return i;
+            }
+        }
+        return ELEMENT_INDEX_MAX;
+    }
+
+private:
+    std::vector<bool> _bits;
+};
+
 using TMeshPointArray = std::vector<MeshPoint>;
 /**
  * Stores all data points of the mesh structure.
@@ -24,9 +24,15 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <vector>
 #endif
 
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+
 #include <Base/Matrix.h>
 #include <Base/Sequencer.h>
 
@@ -598,46 +604,111 @@ bool MeshFixSingleFacet::Fixup()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate()
+namespace
+{
+/**
+ * The MeshSelfIntersectionSearch class tests the facet pairs of each grid element for
+ * intersections. The grid elements are independent of each other and are processed concurrently
+ * in batches. Between two batches the progress is updated and the user may abort the search.
+ */
+class MeshSelfIntersectionSearch
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
+public:
+    using FacetPair = std::pair<FacetIndex, FacetIndex>;
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+    explicit MeshSelfIntersectionSearch(const MeshKernel& rclMesh)
+        : _rclMesh(rclMesh)
+        , _cGrid(rclMesh)
+    {
+        // Contains bounding boxes for every facet
+        MeshFacetIterator cMFI(_rclMesh);
+        _boxes.reserve(_rclMesh.CountFacets());
+        for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
+            _boxes.push_back((*cMFI).GetBoundBox());
+        }
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+        // Only grid elements with at least two facets need to be checked
+        unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
+        _cGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+        for (unsigned long ulX = 0; ulX < ulGridX; ulX++) {
+            for (unsigned long ulY = 0; ulY < ulGridY; ulY++) {
+                for (unsigned long ulZ = 0; ulZ < ulGridZ; ulZ++) {
+                    if (_cGrid.GetCtElements(ulX, ulY, ulZ) > 1) {
+                        _cells.push_back(_cGrid.GetIndexToPosition(ulX, ulY, ulZ));
+                    }
+                }
+            }
+        }
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
+    /**
+     * Returns the pairs of intersecting facets sorted and without duplicates. If \a firstOnly
+     * is true the search stops as soon as an intersection is found.
+     */
+    std::vector<FacetPair> Search(bool firstOnly, bool canAbort)
+    {
+        _firstOnly = firstOnly;
+        _found = false;
+
+        const std::size_t batchSize =
+            16 * std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        const std::size_t numBatches = (_cells.size() + batchSize - 1) / batchSize;
+
+        std::vector<FacetPair> intersection;
+        Base::SequencerLauncher seq("Checking for self-intersections...", numBatches);
+        for (std::size_t start = 0; start < _cells.size(); start += batchSize) {
+            std::size_t end = std::min(start + batchSize, _cells.size());
+            std::vector<unsigned long> batch(_cells.begin() + start, _cells.begin() + end);
+
+            // NOLINTBEGIN
+            QFuture<std::vector<FacetPair>> future = QtConcurrent::mapped(
+                batch,
+                std::bind(&MeshSelfIntersectionSearch::SearchCell, this, std::placeholders::_1));
+            // NOLINTEND
+            QFutureWatcher<std::vector<FacetPair>> watcher;
+            watcher.setFuture(future);
+            watcher.waitForFinished();
+            for (const auto& it : future) {
+                intersection.insert(intersection.end(), it.begin(), it.end());
+            }
 
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
+            seq.next(canAbort);
+            if (_firstOnly && !intersection.empty()) {
+                break;
+            }
+        }
+
+        // a pair of facets can be registered in several grid elements
+        std::sort(intersection.begin(), intersection.end());
+        intersection.erase(std::unique(intersection.begin(), intersection.end()),
+                           intersection.end());
+        return intersection;
+    }
+
+private:
+    std::vector<FacetPair> SearchCell(unsigned long ulCell) const
+    {
+        std::vector<FacetPair> intersection;
+        unsigned long ulX {}, ulY {}, ulZ {};
+        if (!_cGrid.GetPositionToIndex(ulCell, ulX, ulY, ulZ)) {
+            return intersection;
         }
 
-        MeshGeomFacet facet1, facet2;
+        // Get the facet indices, belonging to the current grid unit
+        std::set<ElementIndex> elements;
+        _cGrid.GetElements(ulX, ulY, ulZ, elements);
+        std::vector<FacetIndex> aulGridElements(elements.begin(), elements.end());
+
+        const MeshFacetArray& rFaces = _rclMesh.GetFacets();
         Base::Vector3f pt1, pt2;
         for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
+            if (_firstOnly && _found) {
+                break;
+            }
+            const Base::BoundBox3f& box1 = _boxes[*it];
+            MeshGeomFacet facet1 = _rclMesh.GetFacet(*it);
             const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
+            for (auto jt = it + 1; jt != aulGridElements.end(); ++jt) {
                 // If the facets share a common vertex we do not check for self-intersections
                 // because they could but usually do not intersect each other and the algorithm
                 // below would detect false-positives, otherwise
@@ -658,21 +729,40 @@ bool MeshEvalSelfIntersection::Evaluate()
                     continue;  // ignore facets sharing a common vertex
                 }
 
-                const Base::BoundBox3f& box2 = boxes[*jt];
+                const Base::BoundBox3f& box2 = _boxes[*jt];
                 if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
+                    MeshGeomFacet facet2 = _rclMesh.GetFacet(*jt);
                     int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
                     if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                        intersection.emplace_back(*it, *jt);
+                        if (_firstOnly) {
+                            _found = true;
+                            return intersection;
+                        }
                     }
                 }
             }
         }
+
+        return intersection;
     }
 
-    return true;
+private:
+    const MeshKernel& _rclMesh;
+    MeshFacetGrid _cGrid;
+    std::vector<Base::BoundBox3f> _boxes;
+    std::vector<unsigned long> _cells;
+    bool _firstOnly {false};
+    mutable std::atomic<bool> _found {false};
+};
+}  // namespace
+
+bool MeshEvalSelfIntersection::Evaluate()
+{
+    // Splits the mesh using grid for speeding up the calculation
+    MeshSelfIntersectionSearch search(_rclMesh);
+    // abort after the first detected self-intersection
+    return search.Search(true, false).empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
@@ -703,77 +793,10 @@ void MeshEvalSelfIntersection::GetIntersections(
 void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
-
     // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
-                    }
-                }
-            }
-        }
-    }
+    MeshSelfIntersectionSearch search(_rclMesh);
+    std::vector<std::pair<FacetIndex, FacetIndex>> pairs = search.Search(false, true);
+    intersection.insert(intersection.end(), pairs.begin(), pairs.end());
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
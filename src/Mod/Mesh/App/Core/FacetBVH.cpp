@@ -0,0 +1,384 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <thread>
+#include <utility>
+#endif
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+
+#include "FacetBVH.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+// Leaves with at most this number of facets are not split further
+constexpr unsigned int maxLeafSize = 4;
+
+// Barycentric weights below this value put the closest point on an edge or a vertex
+constexpr float weightTolerance = 1e-5F;
+
+float distanceToBox(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+{
+    float dx = std::max({box.MinX - pnt.x, 0.0F, pnt.x - box.MaxX});
+    float dy = std::max({box.MinY - pnt.y, 0.0F, pnt.y - box.MaxY});
+    float dz = std::max({box.MinZ - pnt.z, 0.0F, pnt.z - box.MaxZ});
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+struct NearestPointBlock
+{
+    const MeshFacetBVH* tree;
+    const std::vector<Base::Vector3f>* points;
+    std::vector<MeshNearestPoint>* result;
+    float maxDist;
+    bool signedDist;
+    std::size_t begin;
+    std::size_t end;
+};
+
+void nearestPoints(NearestPointBlock& block)
+{
+    for (std::size_t i = block.begin; i < block.end; i++) {
+        block.tree->NearestPoint((*block.points)[i],
+                                 block.maxDist,
+                                 block.signedDist,
+                                 (*block.result)[i]);
+    }
+}
+}  // namespace
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh)
+    : _mesh(mesh)
+{
+    Build();
+}
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh, const Base::Matrix4D& mat)
+    : _mesh(mesh)
+    , _transform(mat)
+    , _transformed(mat != Base::Matrix4D())
+{
+    Build();
+}
+
+MeshGeomFacet MeshFacetBVH::GetFacet(FacetIndex index) const
+{
+    MeshGeomFacet facet = _mesh.GetFacet(index);
+    if (_transformed) {
+        facet.Transform(_transform);
+    }
+    return facet;
+}
+
+Base::BoundBox3f MeshFacetBVH::GetBoundBox() const
+{
+    if (_nodes.empty()) {
+        return {};
+    }
+    return _nodes.front().box;
+}
+
+void MeshFacetBVH::Build()
+{
+    std::size_t numFacets = _mesh.CountFacets();
+    if (numFacets == 0) {
+        return;
+    }
+
+    std::vector<Base::BoundBox3f> boxes;
+    std::vector<Base::Vector3f> centers;
+    boxes.reserve(numFacets);
+    centers.reserve(numFacets);
+    _order.reserve(numFacets);
+    for (FacetIndex index = 0; index < numFacets; index++) {
+        MeshGeomFacet facet = GetFacet(index);
+        boxes.push_back(facet.GetBoundBox());
+        centers.push_back(facet.GetGravityPoint());
+        _order.push_back(index);
+    }
+
+    // a binary tree has less than twice as many nodes as leaves
+    _nodes.reserve(2 * (numFacets / maxLeafSize + 1));
+    BuildNode(boxes, centers, 0, static_cast<unsigned int>(numFacets));
+}
+
+unsigned int MeshFacetBVH::BuildNode(const std::vector<Base::BoundBox3f>& boxes,
+                                     const std::vector<Base::Vector3f>& centers,
+                                     unsigned int first,
+                                     unsigned int count)
+{
+    auto index = static_cast<unsigned int>(_nodes.size());
+    _nodes.emplace_back();
+
+    Base::BoundBox3f box;
+    Base::BoundBox3f centerBox;
+    for (unsigned int i = first; i < first + count; i++) {
+        box.Add(boxes[_order[i]]);
+        centerBox.Add(centers[_order[i]]);
+    }
+    _nodes[index].box = box;
+
+    // split at the median along the longest side of the facet centers
+    unsigned short axis = 0;
+    float length = centerBox.LengthX();
+    if (centerBox.LengthY() > length) {
+        axis = 1;
+        length = centerBox.LengthY();
+    }
+    if (centerBox.LengthZ() > length) {
+        axis = 2;
+        length = centerBox.LengthZ();
+    }
+
+    if (count <= maxLeafSize || length <= 0.0F) {
+        _nodes[index].first = first;
+        _nodes[index].count = count;
+        return index;
+    }
+
+    unsigned int half = count / 2;
+    auto begin = _order.begin() + first;
+    std::nth_element(begin, begin + half, begin + count, [&](FacetIndex a, FacetIndex b) {
+        return centers[a][axis] < centers[b][axis];
+    });
+
+    BuildNode(boxes, centers, first, half);
+    unsigned int right = BuildNode(boxes, centers, first + half, count - half);
+    _nodes[index].first = right;
+    return index;
+}
+
+FacetIndex MeshFacetBVH::SearchNearestFromPoint(const Base::Vector3f& pnt) const
+{
+    float dist {};
+    return SearchNearestFromPoint(pnt, FLT_MAX, dist);
+}
+
+FacetIndex
+MeshFacetBVH::SearchNearestFromPoint(const Base::Vector3f& pnt, float maxDist, float& dist) const
+{
+    FacetIndex nearest = FACET_INDEX_MAX;
+    float minDist = maxDist;
+    if (_nodes.empty()) {
+        dist = minDist;
+        return nearest;
+    }
+
+    std::vector<std::pair<float, unsigned int>> stack;
+    stack.emplace_back(distanceToBox(_nodes.front().box, pnt), 0);
+    while (!stack.empty()) {
+        auto [boxDist, index] = stack.back();
+        stack.pop_back();
+        if (boxDist >= minDist) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.count > 0) {
+            for (unsigned int i = node.first; i < node.first + node.count; i++) {
+                float facetDist = GetFacet(_order[i]).DistanceToPoint(pnt);
+                if (facetDist < minDist) {
+                    minDist = facetDist;
+                    nearest = _order[i];
+                }
+            }
+        }
+        else {
+            // push the farther child first so that the nearer one is visited next
+            unsigned int left = index + 1;
+            unsigned int right = node.first;
+            float leftDist = distanceToBox(_nodes[left].box, pnt);
+            float rightDist = distanceToBox(_nodes[right].box, pnt);
+            if (leftDist < rightDist) {
+                stack.emplace_back(rightDist, right);
+                stack.emplace_back(leftDist, left);
+            }
+            else {
+                stack.emplace_back(leftDist, left);
+                stack.emplace_back(rightDist, right);
+            }
+        }
+    }
+
+    dist = minDist;
+    return nearest;
+}
+
+bool MeshFacetBVH::NearestPoint(const Base::Vector3f& pnt,
+                                float maxDist,
+                                bool signedDist,
+                                MeshNearestPoint& result) const
+{
+    float dist {};
+    FacetIndex index = SearchNearestFromPoint(pnt, maxDist, dist);
+    result = MeshNearestPoint();
+    if (index == FACET_INDEX_MAX) {
+        return false;
+    }
+
+    MeshGeomFacet facet = GetFacet(index);
+    facet.DistanceToPoint(pnt, result.point);
+    facet.Weights(result.point, result.weights[0], result.weights[1], result.weights[2]);
+    result.facet = index;
+    result.distance = dist;
+    if (signedDist && (pnt - result.point) * PseudoNormal(index, result.weights) < 0.0F) {
+        result.distance = -dist;
+    }
+
+    return true;
+}
+
+void MeshFacetBVH::BuildPointNormals() const
+{
+    // each facet adds its normal weighted by its angle at the corner
+    _pointNormals.resize(_mesh.CountPoints());
+    const MeshFacetArray& facets = _mesh.GetFacets();
+    for (FacetIndex index = 0; index < facets.size(); index++) {
+        MeshGeomFacet facet = GetFacet(index);
+        Base::Vector3f normal = facet.GetNormal();
+        for (int i = 0; i < 3; i++) {
+            Base::Vector3f dir1 = facet._aclPoints[(i + 1) % 3] - facet._aclPoints[i];
+            Base::Vector3f dir2 = facet._aclPoints[(i + 2) % 3] - facet._aclPoints[i];
+            float angle = dir1.GetAngle(dir2);
+            if (std::isfinite(angle)) {
+                _pointNormals[facets[index]._aulPoints[i]] += angle * normal;
+            }
+        }
+    }
+}
+
+Base::Vector3f MeshFacetBVH::PseudoNormal(FacetIndex index, const float weights[3]) const
+{
+    const MeshFacet& face = _mesh.GetFacets()[index];
+    Base::Vector3f normal = GetFacet(index).GetNormal();
+
+    int numZero = 0;
+    int corner = 0;
+    for (int i = 0; i < 3; i++) {
+        if (weights[i] < weightTolerance) {
+            numZero++;
+        }
+        else {
+            corner = i;
+        }
+    }
+
+    // closest point is a corner of the facet
+    if (numZero == 2) {
+        std::call_once(_pointNormalsBuilt, &MeshFacetBVH::BuildPointNormals, this);
+        return _pointNormals[face._aulPoints[corner]];
+    }
+
+    // closest point is on the edge opposite to the corner with the zero weight
+    if (numZero == 1) {
+        for (int i = 0; i < 3; i++) {
+            if (weights[i] < weightTolerance) {
+                FacetIndex neighbour = face._aulNeighbours[(i + 1) % 3];
+                if (neighbour != FACET_INDEX_MAX) {
+                    normal += GetFacet(neighbour).GetNormal();
+                }
+            }
+        }
+    }
+
+    return normal;
+}
+
+std::vector<MeshNearestPoint> MeshFacetBVH::NearestPoints(const std::vector<Base::Vector3f>& pnts,
+                                                          float maxDist,
+                                                          bool signedDist) const
+{
+    std::vector<MeshNearestPoint> result(pnts.size());
+
+    const std::size_t minBlockSize = 1024;
+    const auto numThreads =
+        static_cast<std::size_t>(std::max(1U, std::thread::hardware_concurrency()));
+    const std::size_t numBlocks = std::min(4 * numThreads, pnts.size() / minBlockSize);
+
+    std::vector<NearestPointBlock> blocks;
+    if (numBlocks < 2) {
+        blocks.push_back({this, &pnts, &result, maxDist, signedDist, 0, pnts.size()});
+        nearestPoints(blocks.front());
+        return result;
+    }
+
+    blocks.reserve(numBlocks);
+    for (std::size_t i = 0; i < numBlocks; i++) {
+        blocks.push_back({this,
+                          &pnts,
+                          &result,
+                          maxDist,
+                          signedDist,
+                          i * pnts.size() / numBlocks,
+                          (i + 1) * pnts.size() / numBlocks});
+    }
+
+    QFuture<void> future = QtConcurrent::map(blocks, &nearestPoints);
+    QFutureWatcher<void> watcher;
+    watcher.setFuture(future);
+    watcher.waitForFinished();
+    return result;
+}
+
+void MeshFacetBVH::Inside(const Base::BoundBox3f& box, std::vector<FacetIndex>& facets) const
+{
+    if (_nodes.empty()) {
+        return;
+    }
+
+    std::vector<unsigned int> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        unsigned int index = stack.back();
+        stack.pop_back();
+        if (!(node.box && box)) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (unsigned int i = node.first; i < node.first + node.count; i++) {
+                if (GetFacet(_order[i]).GetBoundBox() && box) {
+                    facets.push_back(_order[i]);
+                }
+            }
+        }
+        else {
+            stack.push_back(node.first);
+            stack.push_back(index + 1);
+        }
+    }
+}
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_FACETBVH_H
+#define MESH_FACETBVH_H
+
+#include <cfloat>
+#include <mutex>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Matrix.h>
+
+#include "Elements.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/** Result of a closest point query against a MeshFacetBVH. */
+struct MeshNearestPoint
+{
+    /// The closest point on the mesh
+    Base::Vector3f point;
+    /// The distance to the closest point, negative if requested and behind the facet
+    float distance {FLT_MAX};
+    /// The facet of the closest point or FACET_INDEX_MAX if there is none
+    FacetIndex facet {FACET_INDEX_MAX};
+    /// The barycentric coordinates of the closest point with respect to the facet
+    float weights[3] {};  // NOLINT
+};
+
+/**
+ * The MeshFacetBVH is a bounding volume hierarchy over the facets of a mesh.
+ * In contrast to MeshFacetGrid its nodes adapt to the local density of the facets
+ * so that the queries stay fast for meshes that mix finely and coarsely tessellated
+ * regions.
+ * The tree keeps a reference to the mesh kernel which therefore must not be
+ * modified as long as the tree is in use.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// Builds the tree for the facets of \a mesh.
+    explicit MeshFacetBVH(const MeshKernel& mesh);
+    /// Builds the tree for the facets of \a mesh transformed by \a mat.
+    MeshFacetBVH(const MeshKernel& mesh, const Base::Matrix4D& mat);
+
+    /** @name Search */
+    //@{
+    /** Searches for the nearest facet from a point. Returns FACET_INDEX_MAX if the mesh is empty.
+     */
+    FacetIndex SearchNearestFromPoint(const Base::Vector3f& pnt) const;
+    /** Searches for the nearest facet from a point with a distance less than \a maxDist and
+     * returns its distance in \a dist. Returns FACET_INDEX_MAX if there is no such facet.
+     */
+    FacetIndex SearchNearestFromPoint(const Base::Vector3f& pnt, float maxDist, float& dist) const;
+    /** Searches for the closest point on the mesh to \a pnt within \a maxDist.
+     * If \a signedDist is true the distance is negative for points behind the mesh. The side
+     * is taken from the angle-weighted pseudo-normal of the closest facet, edge or vertex, so
+     * that it is also correct if the closest point lies on an edge or a vertex.
+     * Returns false if there is no facet within \a maxDist.
+     */
+    bool NearestPoint(const Base::Vector3f& pnt,
+                      float maxDist,
+                      bool signedDist,
+                      MeshNearestPoint& result) const;
+    /** Runs NearestPoint() for all points of \a pnts. Large inputs are split into blocks
+     * that are processed in parallel.
+     */
+    std::vector<MeshNearestPoint> NearestPoints(const std::vector<Base::Vector3f>& pnts,
+                                                float maxDist = FLT_MAX,
+                                                bool signedDist = false) const;
+    /** Searches for the facets whose bounding boxes intersect with \a box. */
+    void Inside(const Base::BoundBox3f& box, std::vector<FacetIndex>& facets) const;
+    //@}
+
+    /** Returns the geometric facet with the transformation of the tree applied. */
+    MeshGeomFacet GetFacet(FacetIndex index) const;
+    /** Returns the bounding box of all facets. */
+    Base::BoundBox3f GetBoundBox() const;
+
+private:
+    void Build();
+    void BuildPointNormals() const;
+    Base::Vector3f PseudoNormal(FacetIndex index, const float weights[3]) const;  // NOLINT
+    unsigned int BuildNode(const std::vector<Base::BoundBox3f>& boxes,
+                           const std::vector<Base::Vector3f>& centers,
+                           unsigned int first,
+                           unsigned int count);
+
+private:
+    /** A leaf holds the facets _order[first] .. _order[first + count - 1]. For an inner node
+     * count is zero, the left child directly follows the node and first is the index of the
+     * right child.
+     */
+    struct Node
+    {
+        Base::BoundBox3f box;
+        unsigned int first {0};
+        unsigned int count {0};
+    };
+
+    const MeshKernel& _mesh;
+    Base::Matrix4D _transform;
+    bool _transformed {false};
+    std::vector<Node> _nodes;
+    std::vector<FacetIndex> _order;
+    // angle-weighted normals of the points, only built for signed distances
+    mutable std::vector<Base::Vector3f> _pointNormals;
+    mutable std::once_flag _pointNormalsBuilt;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_FACETBVH_H
@@ -25,11 +25,16 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string_view>
+#include <vector>
 #endif
 
+#include <QFile>
+#include <QtConcurrentMap>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/convert.hpp>
 #include <boost/convert/spirit.hpp>
@@ -241,7 +246,20 @@ bool MeshInput::LoadAny(const char* FileName)
     // read file
     bool ok = false;
     if (fi.hasExtension({"stl", "ast"})) {
-        ok = LoadSTL(str);
+        // Map the file into memory to parse it in parallel and fall back to the stream
+        // if the file cannot be mapped.
+        QFile file(QString::fromUtf8(FileName));
+        const uchar* data = nullptr;
+        if (file.open(QIODevice::ReadOnly) && file.size() > 0) {
+            data = file.map(0, file.size());
+        }
+        if (data) {
+            ok = LoadSTL(reinterpret_cast<const char*>(data),  // NOLINT
+                         static_cast<std::size_t>(file.size()));
+        }
+        else {
+            ok = LoadSTL(str);
+        }
     }
     else if (fi.hasExtension("iv")) {
         ok = LoadInventor(str);
@@ -312,6 +330,19 @@ bool MeshInput::LoadFormat(std::istream& input, MeshIO::Format fmt)
     }
 }
 
+namespace
+{
+/**
+ * Checks if the upper-case characters that follow the header and the facet count of an STL
+ * file contain keywords of an ASCII STL file.
+ */
+bool hasAsciiSTLKeywords(const char* szBuf)
+{
+    return strstr(szBuf, "SOLID") || strstr(szBuf, "FACET") || strstr(szBuf, "NORMAL")
+        || strstr(szBuf, "VERTEX") || strstr(szBuf, "ENDFACET") || strstr(szBuf, "ENDLOOP");
+}
+}  // namespace
+
 /** Loads an STL file either in binary or ASCII format.
  * Therefore the file header gets checked to decide if the file is binary or not.
  */
@@ -348,9 +379,7 @@ bool MeshInput::LoadSTL(std::istream& input)
     boost::algorithm::to_upper(szBuf);
 
     try {
-        if (!strstr(szBuf, "SOLID") && !strstr(szBuf, "FACET") && !strstr(szBuf, "NORMAL")
-            && !strstr(szBuf, "VERTEX") && !strstr(szBuf, "ENDFACET")
-            && !strstr(szBuf, "ENDLOOP")) {
+        if (!hasAsciiSTLKeywords(szBuf)) {
             // probably binary STL
             buf->pubseekoff(0, std::ios::beg, std::ios::in);
             return LoadBinarySTL(input);
@@ -720,71 +749,93 @@ bool MeshInput::LoadMeshNode(std::istream& input)
     return true;
 }
 
+namespace
+{
+/**
+ * Checks if an upper-case line of an ASCII STL file starts with the given keywords followed by
+ * three numbers and nothing else, and returns the numbers in \a vec.
+ */
+bool parseAsciiSTLLine(const std::string& line,
+                       std::initializer_list<const char*> keywords,
+                       Base::Vector3f& vec)
+{
+    auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    };
+
+    const char* str = line.c_str();
+    for (const char* keyword : keywords) {
+        while (isSpace(*str)) {
+            ++str;
+        }
+        std::size_t len = std::strlen(keyword);
+        if (std::strncmp(str, keyword, len) != 0) {
+            return false;
+        }
+        str += len;
+        if (!isSpace(*str)) {
+            return false;
+        }
+    }
+
+    float coords[3];
+    for (float& coord : coords) {
+        char* end {};
+        coord = std::strtof(str, &end);
+        if (end == str) {
+            return false;
+        }
+        str = end;
+    }
+
+    while (isSpace(*str)) {
+        ++str;
+    }
+    if (*str != '\0') {
+        return false;
+    }
+
+    vec.Set(coords[0], coords[1], coords[2]);
+    return true;
+}
+}  // namespace
+
 /** Loads an ASCII STL file. */
 bool MeshInput::LoadAsciiSTL(std::istream& input)
 {
-    boost::regex rx_p("^\\s*VERTEX\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_f("^\\s*FACET\\s+NORMAL\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::cmatch what;
-
     std::string line;
-    float fX {}, fY {}, fZ {};
-    unsigned long ulVertexCt {}, ulFacetCt {};
+    unsigned long ulVertexCt {};
     MeshGeomFacet clFacet;
+    Base::Vector3f vec;
 
     if (!input || input.bad()) {
         return false;
     }
 
+    // The file is read only once. A facet takes roughly 250 bytes, which is good enough
+    // to reserve the memory of the builder.
     std::streamoff ulSize = 0;
     std::streambuf* buf = input.rdbuf();
+    std::streamoff ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
     ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
-    ulSize -= 20;
-
-    // count facets
-    while (std::getline(input, line)) {
-        boost::algorithm::to_upper(line);
-        if (line.find("ENDFACET") != std::string::npos) {
-            ulFacetCt++;
-        }
-        // prevent from reading EOF (as I don't know how to reread the file then)
-        if (input.tellg() > ulSize) {
-            break;
-        }
-        if (line.find("ENDSOLID") != std::string::npos) {
-            break;
-        }
-    }
-
-    // restart from the beginning
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
+    buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
 
 #if 0
     MeshBuilder builder(this->_rclMesh);
 #else
     MeshFastBuilder builder(this->_rclMesh);
 #endif
-    builder.Initialize(ulFacetCt);
+    if (ulSize > ulCurr && ulCurr >= 0) {
+        builder.Initialize(static_cast<MeshFastBuilder::size_type>((ulSize - ulCurr) / 250));
+    }
 
-    ulVertexCt = 0;
     while (std::getline(input, line)) {
         boost::algorithm::to_upper(line);
-        if (boost::regex_match(line.c_str(), what, rx_f)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            clFacet.SetNormal(Base::Vector3f(fX, fY, fZ));
+        if (parseAsciiSTLLine(line, {"FACET", "NORMAL"}, vec)) {
+            clFacet.SetNormal(vec);
         }
-        else if (boost::regex_match(line.c_str(), what, rx_p)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            clFacet._aclPoints[ulVertexCt++].Set(fX, fY, fZ);
+        else if (parseAsciiSTLLine(line, {"VERTEX"}, vec)) {
+            clFacet._aclPoints[ulVertexCt++] = vec;
             if (ulVertexCt == 3) {
                 ulVertexCt = 0;
                 builder.AddFacet(clFacet);
@@ -842,17 +893,186 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
 #endif
     builder.Initialize(ulCt);
 
-    for (uint32_t i = 0; i < ulCt; i++) {
-        // read normal, points
-        input.read((char*)&clVects, sizeof(clVects));
+    // Read the facets in blocks instead of field by field. Each record holds the normal,
+    // the three points and a 2 bytes attribute that is skipped.
+    constexpr uint32_t blockSize = 4096;
+    constexpr std::size_t recordSize = sizeof(clVects) + sizeof(usAtt);
+    std::vector<char> block(blockSize * recordSize);
+    for (uint32_t i = 0; i < ulCt; i += blockSize) {
+        uint32_t count = std::min(blockSize, ulCt - i);
+        input.read(block.data(), static_cast<std::streamsize>(count * recordSize));
+
+        const char* record = block.data();
+        for (uint32_t j = 0; j < count; j++, record += recordSize) {
+            std::memcpy(clVects, record, sizeof(clVects));
+            std::swap(clVects[0], clVects[3]);
+            builder.AddFacet(clVects);
+        }
+    }
+
+    builder.Finish();
+
+    return true;
+}
+
+/** Loads an STL file either in binary or ASCII format from memory.
+ * The same header check as for streams decides if the file is binary or not.
+ */
+bool MeshInput::LoadSTL(const char* data, std::size_t size)
+{
+    char szBuf[200];
+    constexpr std::size_t headerSize = 80 + sizeof(uint32_t);
+
+    uint32_t ulCt {}, ulBytes = 50;
+    if (size >= headerSize) {
+        std::memcpy(&ulCt, data + 80, sizeof(ulCt));  // NOLINT
+    }
+    if (ulCt > 1) {
+        ulBytes = 100;
+    }
+    if (size < headerSize + ulBytes) {
+        return (ulCt == 0);
+    }
+    std::memcpy(szBuf, data + headerSize, ulBytes);  // NOLINT
+    szBuf[ulBytes] = 0;
+    boost::algorithm::to_upper(szBuf);
+
+    try {
+        if (!hasAsciiSTLKeywords(szBuf)) {
+            return LoadBinarySTL(data, size);
+        }
+        return LoadAsciiSTL(data, size);
+    }
+    catch (...) {
+        _rclMesh.Clear();
+        throw;
+    }
+}
+
+namespace
+{
+using TextChunk = std::pair<const char*, const char*>;
+
+/**
+ * Splits the text into chunks of whole lines. The chunk size is fixed so that the chunks
+ * don't depend on the number of threads.
+ */
+std::vector<TextChunk> splitLines(const char* begin, const char* end)
+{
+    constexpr std::ptrdiff_t chunkSize = 1 << 22;
+    std::vector<TextChunk> chunks;
+    const char* pos = begin;
+    while (pos < end) {
+        const char* next = end - pos > chunkSize ? pos + chunkSize : end;  // NOLINT
+        next = std::find(next, end, '\n');
+        if (next != end) {
+            ++next;
+        }
+        chunks.emplace_back(pos, next);
+        pos = next;
+    }
+    return chunks;
+}
+
+struct AsciiSTLChunk
+{
+    TextChunk text;
+    std::vector<Base::Vector3f> vertices;
+};
+
+void parseAsciiSTLChunk(AsciiSTLChunk& chunk)
+{
+    std::string line;
+    Base::Vector3f vec;
+    const char* pos = chunk.text.first;
+    const char* end = chunk.text.second;
+    while (pos < end) {
+        const char* eol = std::find(pos, end, '\n');
+        line.assign(pos, eol);
+        pos = eol == end ? end : eol + 1;
+        boost::algorithm::to_upper(line);
+        // the builder computes the normals itself, so only the vertices are needed
+        if (parseAsciiSTLLine(line, {"VERTEX"}, vec)) {
+            chunk.vertices.push_back(vec);
+        }
+    }
+}
+}  // namespace
+
+/** Loads an ASCII STL file from memory. Chunks of lines are parsed in parallel. */
+bool MeshInput::LoadAsciiSTL(const char* data, std::size_t size)
+{
+    std::vector<AsciiSTLChunk> chunks;
+    for (const auto& text : splitLines(data, data + size)) {  // NOLINT
+        chunks.push_back({text, {}});
+    }
+    QtConcurrent::blockingMap(chunks, parseAsciiSTLChunk);
+
+    std::size_t ulVertexCt = 0;
+    for (const auto& chunk : chunks) {
+        ulVertexCt += chunk.vertices.size();
+    }
+
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.Initialize(static_cast<MeshFastBuilder::size_type>(ulVertexCt / 3));
+
+    // A facet may span two chunks, so the vertices are grouped in order
+    Base::Vector3f clVects[3];
+    int index = 0;
+    for (auto& chunk : chunks) {
+        for (const auto& vec : chunk.vertices) {
+            clVects[index++] = vec;
+            if (index == 3) {
+                index = 0;
+                builder.AddFacet(clVects);
+            }
+        }
+        chunk.vertices = std::vector<Base::Vector3f>();
+    }
+
+    builder.Finish();
+
+    return true;
+}
+
+/** Loads a binary STL file from memory. Blocks of facets are decoded in parallel. */
+bool MeshInput::LoadBinarySTL(const char* data, std::size_t size)
+{
+    constexpr std::size_t headerSize = 80 + sizeof(uint32_t);
+    constexpr std::size_t recordSize = 50;
+    constexpr uint32_t blockSize = 4096;
 
-        std::swap(clVects[0], clVects[3]);
-        builder.AddFacet(clVects);
+    if (size < headerSize) {
+        return false;
+    }
+
+    uint32_t ulCt = 0;
+    std::memcpy(&ulCt, data + 80, sizeof(ulCt));  // NOLINT
 
-        // overread 2 bytes attribute
-        input.read((char*)&usAtt, sizeof(usAtt));
+    // compare the read value with the number of facets the file can hold
+    if (ulCt > (size - headerSize) / recordSize) {
+        return false;  // not a valid STL file
     }
 
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.Resize(static_cast<MeshFastBuilder::size_type>(ulCt));
+
+    std::vector<uint32_t> blocks;
+    for (uint32_t i = 0; i < ulCt; i += blockSize) {
+        blocks.push_back(i);
+    }
+
+    // Each record holds the normal, the three points and a 2 bytes attribute that is skipped
+    const char* records = data + headerSize;  // NOLINT
+    QtConcurrent::blockingMap(blocks, [&builder, records, ulCt](uint32_t first) {
+        Base::Vector3f clVects[4];
+        uint32_t last = ulCt - first > blockSize ? first + blockSize : ulCt;
+        for (uint32_t i = first; i < last; i++) {
+            std::memcpy(clVects, records + std::size_t(i) * recordSize, sizeof(clVects));  // NOLINT
+            builder.SetFacet(static_cast<MeshFastBuilder::size_type>(i), &clVects[1]);
+        }
+    });
+
     builder.Finish();
 
     return true;
@@ -1646,6 +1866,17 @@ bool MeshOutput::SaveBinarySTL(std::ostream& output) const
     uint32_t uCtFts = (uint32_t)_rclMesh.CountFacets();
     output.write((const char*)&uCtFts, sizeof(uCtFts));
 
+    // The facets are written in blocks, each record holds the normal, the three points and
+    // the attribute
+    constexpr std::size_t blockSize = 4096;
+    constexpr std::size_t recordSize = 12 * sizeof(float) + sizeof(usAtt);
+    std::vector<char> block;
+    block.reserve(blockSize * recordSize);
+    auto append = [&block](const void* data, std::size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        block.insert(block.end(), bytes, bytes + size);
+    };
+
     usAtt = 0;
     clIter.Begin();
     clEnd.End();
@@ -1653,24 +1884,31 @@ bool MeshOutput::SaveBinarySTL(std::ostream& output) const
         pclFacet = &(*clIter);
         // normal
         Base::Vector3f normal = pclFacet->GetNormal();
-        output.write((const char*)&(normal.x), sizeof(float));
-        output.write((const char*)&(normal.y), sizeof(float));
-        output.write((const char*)&(normal.z), sizeof(float));
+        append(&(normal.x), sizeof(float));
+        append(&(normal.y), sizeof(float));
+        append(&(normal.z), sizeof(float));
 
         // vertices
         for (uint32_t i = 0; i < 3; i++) {
-            output.write((const char*)&(pclFacet->_aclPoints[i].x), sizeof(float));
-            output.write((const char*)&(pclFacet->_aclPoints[i].y), sizeof(float));
-            output.write((const char*)&(pclFacet->_aclPoints[i].z), sizeof(float));
+            append(&(pclFacet->_aclPoints[i].x), sizeof(float));
+            append(&(pclFacet->_aclPoints[i].y), sizeof(float));
+            append(&(pclFacet->_aclPoints[i].z), sizeof(float));
         }
 
         // attribute
-        output.write((const char*)&usAtt, sizeof(usAtt));
+        append(&usAtt, sizeof(usAtt));
+
+        if (block.size() >= blockSize * recordSize) {
+            output.write(block.data(), static_cast<std::streamsize>(block.size()));
+            block.clear();
+        }
 
         ++clIter;
         seq.next(true);  // allow one to cancel
     }
 
+    output.write(block.data(), static_cast<std::streamsize>(block.size()));
+
     return true;
 }
 
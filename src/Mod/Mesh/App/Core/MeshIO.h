@@ -127,10 +127,18 @@ public:
      * Therefore the file header gets checked to decide if the file is binary or not.
      */
     bool LoadSTL(std::istream& input);
+    /** Loads an STL file either in binary or ASCII format from memory, e.g. a memory-mapped file.
+     * The facets are parsed in parallel.
+     */
+    bool LoadSTL(const char* data, std::size_t size);
     /** Loads an ASCII STL file. */
     bool LoadAsciiSTL(std::istream& input);
+    /** Loads an ASCII STL file from memory. */
+    bool LoadAsciiSTL(const char* data, std::size_t size);
     /** Loads a binary STL file. */
     bool LoadBinarySTL(std::istream& input);
+    /** Loads a binary STL file from memory. */
+    bool LoadBinarySTL(const char* data, std::size_t size);
     /** Loads an OBJ Mesh file. */
     bool LoadOBJ(std::istream& input);
     /** Loads an OBJ Mesh file. */
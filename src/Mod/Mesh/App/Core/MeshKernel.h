@@ -250,6 +250,20 @@ public:
      */
     unsigned long VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
                                                   FacetIndex ulStartFacet) const;
+    /**
+     * Does the same as VisitNeighbourFacets() unless the visited facets are marked in
+     * \a rclVisited instead of by the VISIT flag. The mesh is not modified.
+     */
+    unsigned long VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
+                                       FacetIndex ulStartFacet,
+                                       MeshFlagSet& rclVisited) const;
+    /**
+     * Does the same as VisitNeighbourFacetsOverCorners() unless the visited facets are marked
+     * in \a rclVisited instead of by the VISIT flag. The mesh is not modified.
+     */
+    unsigned long VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
+                                                  FacetIndex ulStartFacet,
+                                                  MeshFlagSet& rclVisited) const;
     //@}
 
     /** @name Point visitors
@@ -272,6 +286,13 @@ public:
      */
     unsigned long VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
                                        PointIndex ulStartPoint) const;
+    /**
+     * Does the same as the method above unless the visited points are marked in \a rclVisited
+     * instead of by the VISIT flag. The mesh is not modified.
+     */
+    unsigned long VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
+                                       PointIndex ulStartPoint,
+                                       MeshFlagSet& rclVisited) const;
     //@}
 
     /** @name Iterators
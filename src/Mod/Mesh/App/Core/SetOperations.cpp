@@ -23,11 +23,18 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <ios>
 #endif
 
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+
 #include <Base/Builder3D.h>
+#include <Base/Converter.h>
 #include <Base/Sequencer.h>
 
 #include "Algorithm.h"
@@ -171,237 +178,254 @@ void SetOperations::Do()
     MeshDefinitions::SetMinPointDistance(saveMinMeshDistance);
 }
 
-void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0,
-                        std::set<FacetIndex>& facetsCuttingEdge1)
+namespace
 {
-    MeshFacetGrid grid1(_cutMesh0, 20);
-    MeshFacetGrid grid2(_cutMesh1, 20);
-
-    unsigned long ctGx1 {}, ctGy1 {}, ctGz1 {};
-    grid1.GetCtGrids(ctGx1, ctGy1, ctGz1);
-
-    for (auto gx1 = 0UL; gx1 < ctGx1; gx1++) {
-        for (auto gy1 = 0UL; gy1 < ctGy1; gy1++) {
-            for (auto gz1 = 0UL; gz1 < ctGz1; gz1++) {
-                if (grid1.GetCtElements(gx1, gy1, gz1) > 0) {
-                    std::vector<FacetIndex> vecFacets2;
-                    grid2.Inside(grid1.GetBoundBox(gx1, gy1, gz1), vecFacets2);
-
-                    if (!vecFacets2.empty()) {
-                        std::set<FacetIndex> vecFacets1;
-                        grid1.GetElements(gx1, gy1, gz1, vecFacets1);
-
-                        std::set<FacetIndex>::iterator it1;
-                        for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1) {
-                            FacetIndex fidx1 = *it1;
-                            MeshGeomFacet f1 = _cutMesh0.GetFacet(*it1);
-
-                            std::vector<FacetIndex>::iterator it2;
-                            for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2) {
-                                FacetIndex fidx2 = *it2;
-                                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
-
-                                MeshPoint p0, p1;
-
-                                int isect = f1.IntersectWithFacet(f2, p0, p1);
-                                if (isect > 0) {
-                                    // optimize cut line if distance to nearest point is too small
-                                    float minDist1 = _minDistanceToPoint,
-                                          minDist2 = _minDistanceToPoint;
-                                    MeshPoint np0 = p0, np1 = p1;
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f1._aclPoints[i] - p0).Length();
-                                        float d2 = (f1._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f1._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            p1 = f1._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    // optimize cut line if distance to nearest point is too small
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f2._aclPoints[i] - p0).Length();
-                                        float d2 = (f2._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f2._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            np1 = f2._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    MeshPoint mp0 = np0;
-                                    MeshPoint mp1 = np1;
-
-                                    if (mp0 != mp1) {
-                                        facetsCuttingEdge0.insert(fidx1);
-                                        facetsCuttingEdge1.insert(fidx2);
-
-                                        _cutPoints.insert(mp0);
-                                        _cutPoints.insert(mp1);
-
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit0 =
-                                            _cutPoints.insert(mp0);
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit1 =
-                                            _cutPoints.insert(mp1);
-
-                                        _edges[Edge(mp0, mp1)] = EdgeInfo();
-
-                                        _facet2points[0][fidx1].push_back(pit0.first);
-                                        _facet2points[0][fidx1].push_back(pit1.first);
-                                        _facet2points[1][fidx2].push_back(pit0.first);
-                                        _facet2points[1][fidx2].push_back(pit1.first);
-                                    }
-                                    else {
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit =
-                                            _cutPoints.insert(mp0);
-
-                                        // do not insert a facet when only one corner point cuts the
-                                        // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
-                                        // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge0.insert(fidx1);
-                                            _facet2points[0][fidx1].push_back(pit.first);
-                                        }
-
-                                        // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
-                                        // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge1.insert(fidx2);
-                                            _facet2points[1][fidx2].push_back(pit.first);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+// Position of the corners of a facet relative to the plane of another facet
+enum class PlaneSide
+{
+    Separated,
+    Coplanar,
+    Crossing
+};
+
+// The orientation test is done in double precision and classifies corners within the
+// tolerance as lying on the plane. This avoids the unreliable float test for nearly
+// coplanar facets.
+PlaneSide classifyFacet(const MeshGeomFacet& facet, const MeshGeomFacet& other, double tolerance)
+{
+    auto base = Base::convertTo<Base::Vector3d>(facet._aclPoints[0]);
+    auto dir1 = Base::convertTo<Base::Vector3d>(facet._aclPoints[1]) - base;
+    auto dir2 = Base::convertTo<Base::Vector3d>(facet._aclPoints[2]) - base;
+    Base::Vector3d normal = dir1 % dir2;
+    double length = normal.Length();
+    if (length == 0.0) {
+        return PlaneSide::Crossing;  // degenerated facet, let the triangle test decide
+    }
+    normal /= length;
+
+    int above = 0;
+    int below = 0;
+    for (const auto& pnt : other._aclPoints) {
+        double dist = normal * (Base::convertTo<Base::Vector3d>(pnt) - base);
+        if (dist > tolerance) {
+            above++;
+        }
+        else if (dist < -tolerance) {
+            below++;
         }
     }
+
+    if (above == 3 || below == 3) {
+        return PlaneSide::Separated;
+    }
+    if (above == 0 && below == 0) {
+        return PlaneSide::Coplanar;
+    }
+    return PlaneSide::Crossing;
 }
 
-void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
+// Cut line between a facet of the first and a facet of the second mesh
+struct FacetCut
+{
+    FacetIndex facet0;
+    FacetIndex facet1;
+    MeshPoint pnt0;
+    MeshPoint pnt1;
+};
+
+/*
+ * Searches the cut lines of two meshes. The facets of the first mesh are processed in
+ * blocks in parallel, each facet is only tested against the facets of the second mesh
+ * whose grid cells overlap its bounding box.
+ */
+class MeshCutSearch
 {
-    // Triangulate Mesh
-    std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator>>::iterator it1;
-    for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1) {
-        std::vector<Vector3f> points;
-        std::set<MeshPoint> pointsSet;
-
-        FacetIndex fidx = it1->first;
-        MeshGeomFacet f = cutMesh.GetFacet(fidx);
-
-        // if (side == 1)
-        //     _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0,
-        //     1, 1);
-
-        // facet corner points
-        // const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
-        for (int i = 0; i < 3; i++)  // NOLINT
-        {
-            pointsSet.insert(f._aclPoints[i]);
-            points.push_back(f._aclPoints[i]);
+public:
+    MeshCutSearch(const MeshKernel& mesh0, const MeshKernel& mesh1, float minDistanceToPoint)
+        : _mesh0(mesh0)
+        , _mesh1(mesh1)
+        , _grid1(mesh1, 20)
+        , _minDistanceToPoint(minDistanceToPoint)
+    {}
+
+    std::vector<FacetCut> Search() const
+    {
+        const FacetIndex blockSize = 1024;
+        std::vector<FacetIndex> blocks;
+        for (FacetIndex index = 0; index < _mesh0.CountFacets(); index += blockSize) {
+            blocks.push_back(index);
         }
 
-        // triangulated facets
-        std::list<std::set<MeshPoint>::iterator>::iterator it2;
-        for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2) {
-            if (pointsSet.find(*(*it2)) == pointsSet.end()) {
-                pointsSet.insert(*(*it2));
-                points.push_back(*(*it2));
-            }
+        // NOLINTBEGIN
+        QFuture<std::vector<FacetCut>> future = QtConcurrent::mapped(
+            blocks,
+            std::bind(&MeshCutSearch::SearchBlock, this, std::placeholders::_1, blockSize));
+        // NOLINTEND
+        QFutureWatcher<std::vector<FacetCut>> watcher;
+        watcher.setFuture(future);
+        watcher.waitForFinished();
+
+        // the blocks are merged in order so that the result doesn't depend on the scheduling
+        std::vector<FacetCut> cuts;
+        for (const auto& it : future) {
+            cuts.insert(cuts.end(), it.begin(), it.end());
         }
+        return cuts;
+    }
+
+private:
+    std::vector<FacetCut> SearchBlock(FacetIndex start, FacetIndex count) const
+    {
+        std::vector<FacetCut> cuts;
+        FacetIndex end = std::min<FacetIndex>(start + count, _mesh0.CountFacets());
+        std::vector<FacetIndex> candidates;
+        for (FacetIndex fidx0 = start; fidx0 < end; fidx0++) {
+            MeshGeomFacet f1 = _mesh0.GetFacet(fidx0);
+            Base::BoundBox3f box1 = f1.GetBoundBox();
+            candidates.clear();
+            _grid1.Inside(box1, candidates);
+
+            for (FacetIndex fidx1 : candidates) {
+                MeshGeomFacet f2 = _mesh1.GetFacet(fidx1);
+                if (!(box1 && f2.GetBoundBox())) {
+                    continue;
+                }
 
-        Vector3f normal = f.GetNormal();
-        Vector3f base = points[0];
-        Vector3f dirX = points[1] - points[0];
-        dirX.Normalize();
-        Vector3f dirY = dirX % normal;
-
-        // project points to 2D plane
-        std::vector<Vector3f>::iterator it;
-        std::vector<Vector3f> vertices;
-        for (it = points.begin(); it != points.end(); ++it) {
-            Vector3f pv = *it;
-            pv.TransformToCoordinateSystem(base, dirX, dirY);
-            vertices.push_back(pv);
+                MeshPoint p0, p1;
+                if (Intersect(f1, f2, p0, p1) > 0) {
+                    cuts.push_back(SnapToCorners(fidx0, fidx1, f1, f2, p0, p1));
+                }
+            }
         }
+        return cuts;
+    }
 
-        DelaunayTriangulator tria;
-        tria.SetPolygon(vertices);
-        tria.TriangulatePolygon();
+    int Intersect(const MeshGeomFacet& f1,
+                  const MeshGeomFacet& f2,
+                  Base::Vector3f& p0,
+                  Base::Vector3f& p1) const
+    {
+        PlaneSide side1 = classifyFacet(f1, f2, _minDistanceToPoint);
+        if (side1 == PlaneSide::Separated) {
+            return 0;
+        }
+        PlaneSide side2 = classifyFacet(f2, f1, _minDistanceToPoint);
+        if (side2 == PlaneSide::Separated) {
+            return 0;
+        }
+        if (side1 == PlaneSide::Coplanar || side2 == PlaneSide::Coplanar) {
+            return f1.IntersectWithCoplanarFacet(f2, p0, p1);
+        }
+        return f1.IntersectWithFacet(f2, p0, p1);
+    }
 
-        std::vector<MeshFacet> facets = tria.GetFacets();
-        for (auto& it : facets) {
-            if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
-                || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
-                continue;
+    // optimize cut line if distance to nearest point is too small
+    FacetCut SnapToCorners(FacetIndex fidx0,
+                           FacetIndex fidx1,
+                           const MeshGeomFacet& f1,
+                           const MeshGeomFacet& f2,
+                           const MeshPoint& p0,
+                           const MeshPoint& p1) const
+    {
+        float minDist1 = _minDistanceToPoint;
+        float minDist2 = _minDistanceToPoint;
+        FacetCut cut {fidx0, fidx1, p0, p1};
+        for (const MeshGeomFacet* facet : {&f1, &f2}) {
+            for (const auto& corner : facet->_aclPoints) {
+                float d1 = (corner - p0).Length();
+                float d2 = (corner - p1).Length();
+                if (d1 < minDist1) {
+                    minDist1 = d1;
+                    cut.pnt0 = corner;
+                }
+                if (d2 < minDist2) {
+                    minDist2 = d2;
+                    cut.pnt1 = corner;
+                }
             }
+        }
+        return cut;
+    }
 
-            MeshGeomFacet facet(points[it._aulPoints[0]],
-                                points[it._aulPoints[1]],
-                                points[it._aulPoints[2]]);
-
-            // if (side == 1)
-            //  _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
-            //  facet._aclPoints[2], true, 3, 0, 1, 1);
-
-            // if (facet.Area() < 0.0001f)
-            //{ // too small facet
-            //   continue;
-            // }
-
-            float dist0 =
-                facet._aclPoints[0].DistanceToLine(facet._aclPoints[1],
-                                                   facet._aclPoints[1] - facet._aclPoints[2]);
-            float dist1 =
-                facet._aclPoints[1].DistanceToLine(facet._aclPoints[0],
-                                                   facet._aclPoints[0] - facet._aclPoints[2]);
-            float dist2 =
-                facet._aclPoints[2].DistanceToLine(facet._aclPoints[0],
-                                                   facet._aclPoints[0] - facet._aclPoints[1]);
-
-            if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
-                || (dist2 < _minDistanceToPoint)) {
-                continue;
-            }
+private:
+    const MeshKernel& _mesh0;
+    const MeshKernel& _mesh1;
+    MeshFacetGrid _grid1;
+    float _minDistanceToPoint;
+};
+}  // namespace
 
-            // dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
-            // dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
-            // dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0,
+                        std::set<FacetIndex>& facetsCuttingEdge1)
+{
+    MeshCutSearch search(_cutMesh0, _cutMesh1, _minDistanceToPoint);
+    std::vector<FacetCut> cuts = search.Search();
 
-            // if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 <
-            // _minDistanceToPoint))
-            //{
-            //   continue;
-            // }
+    for (const auto& cut : cuts) {
+        FacetIndex fidx1 = cut.facet0;
+        FacetIndex fidx2 = cut.facet1;
+        const MeshPoint& mp0 = cut.pnt0;
+        const MeshPoint& mp1 = cut.pnt1;
 
-            facet.CalcNormal();
-            if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
-                std::swap(facet._aclPoints[0], facet._aclPoints[1]);
-                facet.CalcNormal();
-            }
+        if (mp0 != mp1) {
+            facetsCuttingEdge0.insert(fidx1);
+            facetsCuttingEdge1.insert(fidx2);
+
+            std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
+            std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
 
+            _edges[Edge(mp0, mp1)] = EdgeInfo();
 
+            _facet2points[0][fidx1].push_back(pit0.first);
+            _facet2points[0][fidx1].push_back(pit1.first);
+            _facet2points[1][fidx2].push_back(pit0.first);
+            _facet2points[1][fidx2].push_back(pit1.first);
+        }
+        else {
+            std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
+
+            facetsCuttingEdge0.insert(fidx1);
+            _facet2points[0][fidx1].push_back(pit.first);
+
+            facetsCuttingEdge1.insert(fidx2);
+            _facet2points[1][fidx2].push_back(pit.first);
+        }
+    }
+}
+
+void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
+{
+    // The facets are triangulated independently of each other
+    std::vector<FacetIndex> cutFacets;
+    cutFacets.reserve(_facet2points[side].size());
+    for (const auto& it : _facet2points[side]) {
+        cutFacets.push_back(it.first);
+    }
+
+    // NOLINTBEGIN
+    QFuture<std::vector<MeshGeomFacet>> future = QtConcurrent::mapped(
+        cutFacets,
+        std::bind(&SetOperations::TriangulateFacet,
+                  this,
+                  std::cref(cutMesh),
+                  side,
+                  std::placeholders::_1));
+    // NOLINTEND
+    QFutureWatcher<std::vector<MeshGeomFacet>> watcher;
+    watcher.setFuture(future);
+    watcher.waitForFinished();
+
+    // Register the new facets at the cut edges in the order of the cut facets
+    std::size_t index = 0;
+    for (const auto& triangles : future) {
+        FacetIndex fidx = cutFacets[index++];
+        for (auto facet : triangles) {
             for (int j = 0; j < 3; j++) {
                 auto eit = _edges.find(Edge(facet._aclPoints[j], facet._aclPoints[(j + 1) % 3]));
 
                 if (eit != _edges.end()) {
 
                     if (eit->second.fcounter[side] < 2) {
-                        // if (side == 0)
-                        //    _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
-                        //    facet._aclPoints[2], true, 3, 0, 1, 1);
-
                         eit->second.facet[side] = fidx;
                         eit->second.facets[side][eit->second.fcounter[side]] = facet;
                         eit->second.fcounter[side]++;
@@ -416,6 +440,85 @@ void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
     }
 }
 
+std::vector<MeshGeomFacet>
+SetOperations::TriangulateFacet(const MeshKernel& cutMesh, int side, FacetIndex fidx) const
+{
+    std::vector<MeshGeomFacet> triangles;
+    std::vector<Vector3f> points;
+    std::set<MeshPoint> pointsSet;
+
+    MeshGeomFacet f = cutMesh.GetFacet(fidx);
+
+    // facet corner points
+    for (int i = 0; i < 3; i++)  // NOLINT
+    {
+        pointsSet.insert(f._aclPoints[i]);
+        points.push_back(f._aclPoints[i]);
+    }
+
+    // triangulated facets
+    const auto& cutPoints = _facet2points[side].at(fidx);
+    for (const auto& it : cutPoints) {
+        if (pointsSet.find(*it) == pointsSet.end()) {
+            pointsSet.insert(*it);
+            points.push_back(*it);
+        }
+    }
+
+    Vector3f normal = f.GetNormal();
+    Vector3f base = points[0];
+    Vector3f dirX = points[1] - points[0];
+    dirX.Normalize();
+    Vector3f dirY = dirX % normal;
+
+    // project points to 2D plane
+    std::vector<Vector3f> vertices;
+    vertices.reserve(points.size());
+    for (const auto& it : points) {
+        Vector3f pv = it;
+        pv.TransformToCoordinateSystem(base, dirX, dirY);
+        vertices.push_back(pv);
+    }
+
+    DelaunayTriangulator tria;
+    tria.SetPolygon(vertices);
+    tria.TriangulatePolygon();
+
+    std::vector<MeshFacet> facets = tria.GetFacets();
+    for (auto& it : facets) {
+        if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
+            || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
+            continue;
+        }
+
+        MeshGeomFacet facet(points[it._aulPoints[0]],
+                            points[it._aulPoints[1]],
+                            points[it._aulPoints[2]]);
+
+        float dist0 = facet._aclPoints[0].DistanceToLine(facet._aclPoints[1],
+                                                         facet._aclPoints[1] - facet._aclPoints[2]);
+        float dist1 = facet._aclPoints[1].DistanceToLine(facet._aclPoints[0],
+                                                         facet._aclPoints[0] - facet._aclPoints[2]);
+        float dist2 = facet._aclPoints[2].DistanceToLine(facet._aclPoints[0],
+                                                         facet._aclPoints[0] - facet._aclPoints[1]);
+
+        if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
+            || (dist2 < _minDistanceToPoint)) {
+            continue;
+        }
+
+        facet.CalcNormal();
+        if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
+            std::swap(facet._aclPoints[0], facet._aclPoints[1]);
+            facet.CalcNormal();
+        }
+
+        triangles.push_back(facet);
+    }
+
+    return triangles;
+}
+
 void SetOperations::CollectFacets(int side, float mult)
 {
     // float distSave = MeshDefinitions::_fMinPointDistance;
@@ -185,6 +185,9 @@ private:
     void Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1);
     /** Trianglute each facets cut with its cutting points */
     void TriangulateMesh(const MeshKernel& cutMesh, int side);
+    /** Triangulate a single facet with its cutting points */
+    std::vector<MeshGeomFacet>
+    TriangulateFacet(const MeshKernel& cutMesh, int side, FacetIndex fidx) const;
     /** search facets for adding (with region growing) */
     void CollectFacets(int side, float mult);
     /** close gap in the mesh */
@@ -22,9 +22,15 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <cmath>
+#include <thread>
 #endif
 
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+
 #include <Base/Tools.h>
 
 #include "Algorithm.h"
@@ -165,103 +171,193 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
     }
 }
 
-LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
-    : AbstractSmoothing(m)
-{}
+namespace
+{
+struct UmbrellaRange
+{
+    UmbrellaOperator* umbrella;
+    double stepsize;
+    std::size_t begin;
+    std::size_t end;
+};
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize)
+void applyUmbrella(UmbrellaRange& range)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
+    range.umbrella->Apply(range.stepsize, range.begin, range.end);
+}
+}  // namespace
 
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
+UmbrellaOperator::UmbrellaOperator(MeshKernel& m)
+    : kernel(m)
+{
+    const MeshPointArray& pnts = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
+    const std::size_t numPoints = pnts.size();
+
+    // each facet adds its two other corners to the neighbours of a point
+    std::vector<std::size_t> numFacets(numPoints, 0);
+    for (const auto& facet : facets) {
+        for (PointIndex index : facet._aulPoints) {
+            numFacets[index]++;
         }
+    }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+    std::vector<std::size_t> start(numPoints + 1, 0);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        start[i + 1] = start[i] + 2 * numFacets[i];
+    }
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
+    std::vector<PointIndex> candidates(start.back());
+    std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+    for (const auto& facet : facets) {
+        for (int i = 0; i < 3; i++) {
+            PointIndex index = facet._aulPoints[i];
+            candidates[fill[index]++] = facet._aulPoints[(i + 1) % 3];
+            candidates[fill[index]++] = facet._aulPoints[(i + 2) % 3];
         }
+    }
 
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
+    // remove duplicates and compact the rows
+    offsets.resize(numPoints + 1);
+    neighbours.reserve(candidates.size() / 2);
+    movable.resize(numPoints, 0);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        auto first = candidates.begin() + static_cast<std::ptrdiff_t>(start[i]);
+        auto last = candidates.begin() + static_cast<std::ptrdiff_t>(start[i + 1]);
+        std::sort(first, last);
+        last = std::unique(first, last);
+
+        offsets[i] = neighbours.size();
+        neighbours.insert(neighbours.end(), first, last);
+
+        // for border points the number of neighbours exceeds the number of facets
+        auto count = static_cast<std::size_t>(std::distance(first, last));
+        movable[i] = (count >= 3 && count == numFacets[i]) ? 1 : 0;
     }
+    offsets[numPoints] = neighbours.size();
+
+    points.assign(pnts.begin(), pnts.end());
+    buffer.resize(numPoints);
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize,
-                                const std::vector<PointIndex>& point_indices)
+void UmbrellaOperator::SetPinned(const std::vector<PointIndex>& pinned)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
+    for (PointIndex index : pinned) {
+        if (index < movable.size()) {
+            movable[index] = 0;
+        }
+    }
+}
 
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
+void UmbrellaOperator::SetActive(const std::vector<PointIndex>& active)
+{
+    std::vector<char> selected(movable.size(), 0);
+    for (PointIndex index : active) {
+        if (index < selected.size()) {
+            selected[index] = movable[index];
         }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
+    }
+    movable.swap(selected);
+}
+
+void UmbrellaOperator::Apply(double stepsize)
+{
+    const std::size_t numPoints = points.size();
+    const std::size_t minRangeSize = 10000;
+    const auto numThreads =
+        static_cast<std::size_t>(std::max(1U, std::thread::hardware_concurrency()));
+    const std::size_t numRanges = std::min(4 * numThreads, numPoints / minRangeSize);
+
+    if (numRanges < 2) {
+        Apply(stepsize, 0, numPoints);
+    }
+    else {
+        std::vector<UmbrellaRange> ranges;
+        ranges.reserve(numRanges);
+        for (std::size_t i = 0; i < numRanges; i++) {
+            ranges.push_back(
+                {this, stepsize, i * numPoints / numRanges, (i + 1) * numPoints / numRanges});
         }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+        QFuture<void> future = QtConcurrent::map(ranges, &applyUmbrella);
+        QFutureWatcher<void> watcher;
+        watcher.setFuture(future);
+        watcher.waitForFinished();
+    }
+
+    points.swap(buffer);
+}
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
+void UmbrellaOperator::Apply(double stepsize, std::size_t begin, std::size_t end)
+{
+    const Base::Vector3f* src = points.data();
+    Base::Vector3f* dst = buffer.data();
+    const PointIndex* adj = neighbours.data();
+
+    for (std::size_t i = begin; i < end; i++) {
+        const Base::Vector3f& pnt = src[i];
+        if (!movable[i]) {
+            dst[i] = pnt;
+            continue;
         }
 
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
+        double sx = 0.0, sy = 0.0, sz = 0.0;
+        const std::size_t first = offsets[i];
+        const std::size_t last = offsets[i + 1];
+        for (std::size_t j = first; j < last; j++) {
+            const Base::Vector3f& nb = src[adj[j]];
+            sx += static_cast<double>(nb.x);
+            sy += static_cast<double>(nb.y);
+            sz += static_cast<double>(nb.z);
+        }
+
+        // move towards the centroid of the neighbours
+        const double w = 1.0 / static_cast<double>(last - first);
+        const auto px = static_cast<double>(pnt.x);
+        const auto py = static_cast<double>(pnt.y);
+        const auto pz = static_cast<double>(pnt.z);
+        dst[i].Set(static_cast<float>(px + stepsize * (w * sx - px)),
+                   static_cast<float>(py + stepsize * (w * sy - py)),
+                   static_cast<float>(pz + stepsize * (w * sz - pz)));
     }
 }
 
+void UmbrellaOperator::Commit()
+{
+    PointIndex count = kernel.CountPoints();
+    for (PointIndex idx = 0; idx < count; idx++) {
+        kernel.SetPoint(idx, points[idx]);
+    }
+}
+
+LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
+    : AbstractSmoothing(m)
+{}
+
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    UmbrellaOperator umbrella(kernel);
+    umbrella.SetPinned(pinned);
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
+        umbrella.Apply(lambda);
     }
+
+    umbrella.Commit();
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations,
                                     const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    UmbrellaOperator umbrella(kernel);
+    umbrella.SetActive(point_indices);
+    umbrella.SetPinned(pinned);
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        umbrella.Apply(lambda);
     }
+
+    umbrella.Commit();
 }
 
 TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
@@ -270,29 +366,34 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    UmbrellaOperator umbrella(kernel);
+    umbrella.SetPinned(GetPinnedPoints());
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda());
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro));
+        umbrella.Apply(GetLambda());
+        umbrella.Apply(-(GetLambda() + micro));
     }
+
+    umbrella.Commit();
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations,
                                    const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    UmbrellaOperator umbrella(kernel);
+    umbrella.SetActive(point_indices);
+    umbrella.SetPinned(GetPinnedPoints());
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda(), point_indices);
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro), point_indices);
+        umbrella.Apply(GetLambda());
+        umbrella.Apply(-(GetLambda() + micro));
     }
+
+    umbrella.Commit();
 }
 
 namespace
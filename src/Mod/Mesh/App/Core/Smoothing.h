@@ -26,6 +26,8 @@
 #include <cfloat>
 #include <vector>
 
+#include <Base/Vector3D.h>
+
 #include "Definitions.h"
 
 
@@ -91,6 +93,37 @@ private:
     float maximum {FLT_MAX};
 };
 
+/*!
+ * \brief The UmbrellaOperator class
+ * Applies the umbrella operator to the points of a mesh. The point neighbourhood
+ * is stored once in compressed row format and each step moves all points at once
+ * (Jacobi update) so that the points can be processed in parallel.
+ * Border points and points with less than three neighbours are never moved.
+ */
+class MeshExport UmbrellaOperator
+{
+public:
+    explicit UmbrellaOperator(MeshKernel&);
+    /** The given points keep their position. */
+    void SetPinned(const std::vector<PointIndex>&);
+    /** Only the given points are moved. */
+    void SetActive(const std::vector<PointIndex>&);
+    /** Moves the points by \a stepsize towards the centroid of their neighbours. */
+    void Apply(double stepsize);
+    /** Writes the smoothed points back to the mesh. */
+    void Commit();
+    /** \internal */
+    void Apply(double stepsize, std::size_t begin, std::size_t end);
+
+private:
+    MeshKernel& kernel;
+    std::vector<std::size_t> offsets;
+    std::vector<PointIndex> neighbours;
+    std::vector<char> movable;
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> buffer;
+};
+
 class MeshExport LaplaceSmoothing: public AbstractSmoothing
 {
 public:
@@ -105,16 +138,19 @@ public:
     {
         return lambda;
     }
-
-protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&,
-                  double,
-                  const std::vector<PointIndex>&);
+    /** The given points keep their position while smoothing. */
+    void SetPinnedPoints(const std::vector<PointIndex>& pnts)
+    {
+        pinned = pnts;
+    }
+    const std::vector<PointIndex>& GetPinnedPoints() const
+    {
+        return pinned;
+    }
 
 private:
     double lambda {0.6307};
+    std::vector<PointIndex> pinned;
 };
 
 class MeshExport TaubinSmoothing: public LaplaceSmoothing
@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <boost/core/ignore_unused.hpp>
+#include <cassert>
 #include <cmath>
 #include <queue>
 #include <utility>
@@ -858,9 +859,31 @@ PointIndex MeshTopoAlgorithm::GetOrAddIndex(const MeshPoint& rclPoint)
     if (retval.second) {
         _rclMesh._aclPointArray.push_back(rclPoint);
     }
+    else if (!_rclMesh._aclPointArray[retval.first->second].IsValid()) {
+        // the cached point has been removed by a previous operation
+        retval.first->second = sz;
+        _rclMesh._aclPointArray.push_back(rclPoint);
+    }
     return retval.first->second;
 }
 
+void MeshTopoAlgorithm::BeginBatch()
+{
+    BeginCache();
+}
+
+void MeshTopoAlgorithm::EndBatch()
+{
+    if (_needsCleanup) {
+        Cleanup();
+    }
+    EndCache();
+
+#if defined(FC_DEBUG)
+    assert(MeshEvalNeighbourhood(_rclMesh).Evaluate());
+#endif
+}
+
 std::vector<FacetIndex> MeshTopoAlgorithm::GetFacetsToPoint(FacetIndex uFacetPos,
                                                             PointIndex uPointPos) const
 {
@@ -900,6 +923,11 @@ void MeshTopoAlgorithm::Cleanup()
 {
     _rclMesh.RemoveInvalids();
     _needsCleanup = false;
+
+    // the point indices have changed
+    if (_cache) {
+        BeginCache();
+    }
 }
 
 bool MeshTopoAlgorithm::CollapseVertex(const VertexCollapse& vc)
@@ -1150,6 +1178,10 @@ bool MeshTopoAlgorithm::CollapseFacet(FacetIndex ulFacetPos)
 
     // move the vertex to the gravity center
     Base::Vector3f cCenter = _rclMesh.GetGravityPoint(rclF);
+    if (_cache) {
+        _cache->erase(_rclMesh._aclPointArray[ulPointInd0]);
+        (*_cache)[cCenter] = ulPointInd0;
+    }
     _rclMesh._aclPointArray[ulPointInd0] = cCenter;
 
     // set the new point indices for all facets that share one of the points to be deleted
@@ -1838,23 +1870,13 @@ void MeshComponents::SearchForComponents(TMode tMode,
         return;
     }
 
-    // reset VISIT flags
-    MeshAlgorithm cAlgo(_rclMesh);
-    cAlgo.SetFacetFlag(MeshFacet::VISIT);
-    cAlgo.ResetFacetsFlag(aSegment, MeshFacet::VISIT);
-
-    const MeshFacetArray& rFAry = _rclMesh.GetFacets();
-    MeshFacetArray::_TConstIterator iTri = rFAry.begin();
-    MeshFacetArray::_TConstIterator iBeg = rFAry.begin();
-    MeshFacetArray::_TConstIterator iEnd = rFAry.end();
+    // only the facets of the segment are not marked as visited, the mesh flags are left untouched
+    MeshFlagSet visited(_rclMesh.CountFacets(), true);
+    visited.Reset(aSegment);
 
     // start from the first not visited facet
-    unsigned long ulVisited = cAlgo.CountFacetFlag(MeshFacet::VISIT);
-    MeshIsNotFlag<MeshFacet> flag;
-    iTri = std::find_if(iTri, iEnd, [flag](const MeshFacet& f) {
-        return flag(f, MeshFacet::VISIT);
-    });
-    ulStartFacet = iTri - iBeg;
+    unsigned long ulVisited = visited.Count();
+    ulStartFacet = visited.FindFirstUnset();
 
     // visitor
     std::vector<FacetIndex> aclComponent;
@@ -1865,10 +1887,11 @@ void MeshComponents::SearchForComponents(TMode tMode,
         // collect all facets of a component
         aclComponent.clear();
         if (tMode == OverEdge) {
-            ulVisited += _rclMesh.VisitNeighbourFacets(clFVisitor, ulStartFacet);
+            ulVisited += _rclMesh.VisitNeighbourFacets(clFVisitor, ulStartFacet, visited);
         }
         else if (tMode == OverPoint) {
-            ulVisited += _rclMesh.VisitNeighbourFacetsOverCorners(clFVisitor, ulStartFacet);
+            ulVisited +=
+                _rclMesh.VisitNeighbourFacetsOverCorners(clFVisitor, ulStartFacet, visited);
         }
 
         // get also start facet
@@ -1876,18 +1899,9 @@ void MeshComponents::SearchForComponents(TMode tMode,
         aclConnectComp.push_back(aclComponent);
 
         // if the mesh consists of several topologic independent components
-        // We can search from position 'iTri' on because all elements _before_ are already visited
-        // what we know from the previous iteration.
-        iTri = std::find_if(iTri, iEnd, [flag](const MeshFacet& f) {
-            return flag(f, MeshFacet::VISIT);
-        });
-
-        if (iTri < iEnd) {
-            ulStartFacet = iTri - iBeg;
-        }
-        else {
-            ulStartFacet = FACET_INDEX_MAX;
-        }
+        // We can search from position 'ulStartFacet' on because all elements _before_ are already
+        // visited what we know from the previous iteration.
+        ulStartFacet = visited.FindFirstUnset(ulStartFacet);
     }
 
     // sort components by size (descending order)
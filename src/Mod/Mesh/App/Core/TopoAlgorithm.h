@@ -280,6 +280,19 @@ public:
      */
     void BeginCache();
     void EndCache();
+    /**
+     * Starts a batch of topological operations. Inside a batch new points are
+     * looked up in a point cache instead of searching the whole point array, and
+     * elements marked as invalid are only removed once by EndBatch().
+     * The neighbourhood of the facets is kept up-to-date by each operation, so
+     * there is no need to rebuild it afterwards.
+     */
+    void BeginBatch();
+    /**
+     * Ends a batch of topological operations, removes all invalid elements and
+     * releases the point cache.
+     */
+    void EndBatch();
 
 private:
     /**
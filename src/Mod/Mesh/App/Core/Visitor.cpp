@@ -34,28 +34,74 @@
 using namespace MeshCore;
 
 
-unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
-                                               FacetIndex ulStartFacet) const
+namespace
+{
+// Marks the visited elements with the VISIT flag of the mesh elements
+template<class Array>
+class ElementVisitFlag
+{
+public:
+    explicit ElementVisitFlag(const Array& elements)
+        : elements(elements)
+    {}
+    bool IsVisited(ElementIndex index) const
+    {
+        return elements[index].IsFlag(Array::value_type::VISIT);
+    }
+    void SetVisited(ElementIndex index) const
+    {
+        elements[index].SetFlag(Array::value_type::VISIT);
+    }
+
+private:
+    const Array& elements;
+};
+
+// Marks the visited elements in a flag set owned by the caller
+class FlagSetVisitFlag
+{
+public:
+    explicit FlagSetVisitFlag(MeshFlagSet& flags)
+        : flags(flags)
+    {}
+    bool IsVisited(ElementIndex index) const
+    {
+        return flags.IsSet(index);
+    }
+    void SetVisited(ElementIndex index) const
+    {
+        flags.Set(index);
+    }
+
+private:
+    MeshFlagSet& flags;
+};
+
+template<class VisitFlag>
+unsigned long visitNeighbourFacets(const MeshFacetArray& raclFAry,
+                                   MeshFacetVisitor& rclFVisitor,
+                                   FacetIndex ulStartFacet,
+                                   const VisitFlag& visited)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
-    unsigned long ulCount = _aclFacetArray.size();
+    unsigned long ulCount = raclFAry.size();
     std::vector<FacetIndex> clCurrentLevel, clNextLevel;
     std::vector<FacetIndex>::iterator clCurrIter;
     MeshFacetArray::_TConstIterator clCurrFacet, clNBFacet;
 
-    if (ulStartFacet >= _aclFacetArray.size()) {
+    if (ulStartFacet >= raclFAry.size()) {
         return 0;
     }
 
     // pick up start point
     clCurrentLevel.push_back(ulStartFacet);
-    _aclFacetArray[ulStartFacet].SetFlag(MeshFacet::VISIT);
+    visited.SetVisited(ulStartFacet);
 
     // as long as free neighbours
     while (!clCurrentLevel.empty()) {
         // visit all neighbours of the current level
         for (clCurrIter = clCurrentLevel.begin(); clCurrIter < clCurrentLevel.end(); ++clCurrIter) {
-            clCurrFacet = _aclFacetArray.begin() + *clCurrIter;
+            clCurrFacet = raclFAry.begin() + *clCurrIter;
 
             // visit all neighbours of the current level if not yet done
             for (unsigned short i = 0; i < 3; i++) {
@@ -68,19 +114,19 @@ unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
                     continue;  // error in data structure
                 }
 
-                clNBFacet = _aclFacetArray.begin() + j;
+                clNBFacet = raclFAry.begin() + j;
 
                 if (!rclFVisitor.AllowVisit(*clNBFacet, *clCurrFacet, j, ulLevel, i)) {
                     continue;
                 }
-                if (clNBFacet->IsFlag(MeshFacet::VISIT)) {
+                if (visited.IsVisited(j)) {
                     continue;  // neighbour facet already visited
                 }
 
                 // visit and mark
                 ulVisited++;
                 clNextLevel.push_back(j);
-                clNBFacet->SetFlag(MeshFacet::VISIT);
+                visited.SetVisited(j);
                 if (!rclFVisitor.Visit(*clNBFacet, *clCurrFacet, j, ulLevel)) {
                     return ulVisited;
                 }
@@ -95,21 +141,24 @@ unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
     return ulVisited;
 }
 
-unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
-                                                          FacetIndex ulStartFacet) const
+template<class VisitFlag>
+unsigned long visitNeighbourFacetsOverCorners(const MeshKernel& rclMesh,
+                                              MeshFacetVisitor& rclFVisitor,
+                                              FacetIndex ulStartFacet,
+                                              const VisitFlag& visited)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
-    MeshRefPointToFacets clRPF(*this);
-    const MeshFacetArray& raclFAry = _aclFacetArray;
+    MeshRefPointToFacets clRPF(rclMesh);
+    const MeshFacetArray& raclFAry = rclMesh.GetFacets();
     MeshFacetArray::_TConstIterator pFBegin = raclFAry.begin();
     std::vector<FacetIndex> aclCurrentLevel, aclNextLevel;
 
-    if (ulStartFacet >= _aclFacetArray.size()) {
+    if (ulStartFacet >= raclFAry.size()) {
         return 0;
     }
 
     aclCurrentLevel.push_back(ulStartFacet);
-    raclFAry[ulStartFacet].SetFlag(MeshFacet::VISIT);
+    visited.SetVisited(ulStartFacet);
 
     while (!aclCurrentLevel.empty()) {
         // visit all neighbours of the current level
@@ -119,12 +168,12 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclF
                 const MeshFacet& rclFacet = raclFAry[*pCurrFacet];
                 const std::set<FacetIndex>& raclNB = clRPF[rclFacet._aulPoints[i]];
                 for (FacetIndex pINb : raclNB) {
-                    if (!pFBegin[pINb].IsFlag(MeshFacet::VISIT)) {
-                        // only visit if VISIT Flag not set
+                    if (!visited.IsVisited(pINb)) {
+                        // only visit if not yet visited
                         ulVisited++;
                         FacetIndex ulFInd = pINb;
                         aclNextLevel.push_back(ulFInd);
-                        pFBegin[pINb].SetFlag(MeshFacet::VISIT);
+                        visited.SetVisited(pINb);
                         if (!rclFVisitor.Visit(pFBegin[pINb],
                                                raclFAry[*pCurrFacet],
                                                ulFInd,
@@ -143,17 +192,20 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclF
     return ulVisited;
 }
 
-unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
-                                               PointIndex ulStartPoint) const
+template<class VisitFlag>
+unsigned long visitNeighbourPoints(const MeshKernel& rclMesh,
+                                   MeshPointVisitor& rclPVisitor,
+                                   PointIndex ulStartPoint,
+                                   const VisitFlag& visited)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
     std::vector<PointIndex> aclCurrentLevel, aclNextLevel;
     std::vector<PointIndex>::iterator clCurrIter;
-    MeshPointArray::_TConstIterator pPBegin = _aclPointArray.begin();
-    MeshRefPointToPoints clNPs(*this);
+    MeshPointArray::_TConstIterator pPBegin = rclMesh.GetPoints().begin();
+    MeshRefPointToPoints clNPs(rclMesh);
 
     aclCurrentLevel.push_back(ulStartPoint);
-    (pPBegin + ulStartPoint)->SetFlag(MeshPoint::VISIT);
+    visited.SetVisited(ulStartPoint);
 
     while (!aclCurrentLevel.empty()) {
         // visit all neighbours of the current level
@@ -161,12 +213,12 @@ unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
              ++clCurrIter) {
             const std::set<PointIndex>& raclNB = clNPs[*clCurrIter];
             for (PointIndex pINb : raclNB) {
-                if (!pPBegin[pINb].IsFlag(MeshPoint::VISIT)) {
-                    // only visit if VISIT Flag not set
+                if (!visited.IsVisited(pINb)) {
+                    // only visit if not yet visited
                     ulVisited++;
                     PointIndex ulPInd = pINb;
                     aclNextLevel.push_back(ulPInd);
-                    pPBegin[pINb].SetFlag(MeshPoint::VISIT);
+                    visited.SetVisited(pINb);
                     if (!rclPVisitor.Visit(pPBegin[pINb],
                                            *(pPBegin + (*clCurrIter)),
                                            ulPInd,
@@ -183,6 +235,61 @@ unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
 
     return ulVisited;
 }
+}  // namespace
+
+unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
+                                               FacetIndex ulStartFacet) const
+{
+    ElementVisitFlag<MeshFacetArray> visited(_aclFacetArray);
+    return visitNeighbourFacets(_aclFacetArray, rclFVisitor, ulStartFacet, visited);
+}
+
+unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
+                                               FacetIndex ulStartFacet,
+                                               MeshFlagSet& rclVisited) const
+{
+    if (rclVisited.Size() < _aclFacetArray.size()) {
+        rclVisited.Resize(_aclFacetArray.size());
+    }
+    FlagSetVisitFlag visited(rclVisited);
+    return visitNeighbourFacets(_aclFacetArray, rclFVisitor, ulStartFacet, visited);
+}
+
+unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
+                                                          FacetIndex ulStartFacet) const
+{
+    ElementVisitFlag<MeshFacetArray> visited(_aclFacetArray);
+    return visitNeighbourFacetsOverCorners(*this, rclFVisitor, ulStartFacet, visited);
+}
+
+unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
+                                                          FacetIndex ulStartFacet,
+                                                          MeshFlagSet& rclVisited) const
+{
+    if (rclVisited.Size() < _aclFacetArray.size()) {
+        rclVisited.Resize(_aclFacetArray.size());
+    }
+    FlagSetVisitFlag visited(rclVisited);
+    return visitNeighbourFacetsOverCorners(*this, rclFVisitor, ulStartFacet, visited);
+}
+
+unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
+                                               PointIndex ulStartPoint) const
+{
+    ElementVisitFlag<MeshPointArray> visited(_aclPointArray);
+    return visitNeighbourPoints(*this, rclPVisitor, ulStartPoint, visited);
+}
+
+unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
+                                               PointIndex ulStartPoint,
+                                               MeshFlagSet& rclVisited) const
+{
+    if (rclVisited.Size() < _aclPointArray.size()) {
+        rclVisited.Resize(_aclPointArray.size());
+    }
+    FlagSetVisitFlag visited(rclVisited);
+    return visitNeighbourPoints(*this, rclPVisitor, ulStartPoint, visited);
+}
 
 // -------------------------------------------------------------------------
 
@@ -1085,7 +1085,7 @@ void MeshObject::decimate(float fTolerance, float fReduction)
 void MeshObject::decimate(int targetSize)
 {
     MeshCore::MeshSimplify dm(this->_kernel);
-    dm.simplify(targetSize);
+    dm.simplifyParallel(targetSize);
 }
 
 Base::Vector3d MeshObject::getPointNormal(PointIndex index) const
@@ -1341,6 +1341,7 @@ void MeshObject::refine()
     unsigned long cnt = _kernel.CountFacets();
     MeshCore::MeshFacetIterator cF(_kernel);
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    topalg.BeginBatch();
 
     // x < 30 deg => cos(x) > sqrt(3)/2 or x > 120 deg => cos(x) < -0.5
     for (unsigned long i = 0; i < cnt; i++) {
@@ -1350,6 +1351,8 @@ void MeshObject::refine()
         }
     }
 
+    topalg.EndBatch();
+
     // clear the segments because we don't know how the new
     // topology looks like
     this->_segments.clear();
@@ -1413,11 +1416,13 @@ void MeshObject::splitEdges()
 
     MeshCore::MeshFacetIterator cIter(_kernel);
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    topalg.BeginBatch();
     for (const auto& it : adjacentFacet) {
         cIter.Set(it.first);
         Base::Vector3f mid = 0.5F * (cIter->_aclPoints[0] + cIter->_aclPoints[2]);
         topalg.SplitEdge(it.first, it.second, mid);
     }
+    topalg.EndBatch();
 
     // clear the segments because we don't know how the new
     // topology looks like
@@ -22,8 +22,10 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <cfloat>
 #include <BRepBuilderAPI_MakePolygon.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
 #endif
 
 #include <Base/Console.h>
@@ -34,6 +36,7 @@
 #include <Base/Vector3D.h>
 #include <Base/VectorPy.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/FacetBVH.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/Part/App/TopoShapeEdgePy.h>
@@ -84,6 +87,16 @@ public:
             "and tolerance."
             "projectPointsOnMesh(list of points, Mesh, Vector, [float]) -> list of points\n"
         );
+        add_keyword_method("nearestPoints",&Module::nearestPoints,
+            "Computes the closest points on a mesh or on a tessellated shape.\n"
+            "nearestPoints(Points, Target, [MaxDistance, Signed=False, Deflection]) -> list\n"
+            "\n"
+            "For each point the list holds a tuple of the distance, the index of the closest\n"
+            "facet, the barycentric coordinates of the closest point and the closest point\n"
+            "itself, or None if the target is farther away than MaxDistance. With Signed=True\n"
+            "the distance is negative for points behind the mesh. A shape is tessellated with\n"
+            "the given Deflection or with its accuracy.\n"
+        );
         add_varargs_method("wireFromSegment",&Module::wireFromSegment,
             "Create wire(s) from boundary of a mesh segment\n"
         );
@@ -139,6 +152,19 @@ public:
             "    SegPerEdge (optional, float)\n"
             "    SegPerRadius (optional, float)\n"
         );
+        add_keyword_method("meshFromShapes",&Module::meshFromShapes,
+            "Create surface meshes from a list of shapes with the standard mesher\n"
+            "\n"
+            "    meshFromShapes(Shapes, LinearDeflection,\n"
+            "                           AngularDeflection=0.5,\n"
+            "                           Relative=False,\n"
+            "                           Segments=False) -> (Meshes, Timings)\n"
+            "\n"
+            "The faces are meshed concurrently. Faces with a common edge are meshed\n"
+            "one after another so that the seams stay watertight.\n"
+            "Meshes contains one mesh per shape. Timings is a list of tuples\n"
+            "(shape index, face index, number of facets, seconds) for every meshed face.\n"
+        );
         initialize("This module is the MeshPart module."); // register with Python
     }
 
@@ -407,6 +433,78 @@ private:
 
         throw Py::Exception();
     }
+    Py::Object nearestPoints(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        static const std::array<const char *, 6> keywords{"Points", "Target", "MaxDistance",
+                                                           "Signed", "Deflection", nullptr};
+        PyObject *seq, *target;
+        double maxDist = FLT_MAX;
+        PyObject* signedDist = Py_False;
+        double deflection = 0.0;
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "OO|dO!d", keywords,
+                                                 &seq, &target, &maxDist,
+                                                 &PyBool_Type, &signedDist, &deflection)) {
+            throw Py::Exception();
+        }
+
+        std::vector<Base::Vector3f> pointsIn;
+        Py::Sequence points(seq);
+        pointsIn.reserve(points.size());
+        for (Py::Sequence::iterator it = points.begin(); it != points.end(); ++it) {
+            Py::Vector pnt(*it);
+            pointsIn.push_back(Base::convertTo<Base::Vector3f>(pnt.toVector()));
+        }
+
+        Mesh::MeshObject tessellation;
+        const Mesh::MeshObject* mesh = nullptr;
+        if (PyObject_TypeCheck(target, &(Mesh::MeshPy::Type))) {
+            mesh = static_cast<Mesh::MeshPy*>(target)->getMeshObjectPtr();
+        }
+        else if (PyObject_TypeCheck(target, &(Part::TopoShapePy::Type))) {
+            const Part::TopoShape* shape = static_cast<Part::TopoShapePy*>(target)->getTopoShapePtr();
+            if (deflection <= 0.0) {
+                deflection = shape->getAccuracy();
+            }
+            std::vector<Base::Vector3d> pnts;
+            std::vector<Data::ComplexGeoData::Facet> facets;
+            shape->getFaces(pnts, facets, deflection);
+            tessellation.setFacets(facets, pnts);
+            mesh = &tessellation;
+        }
+        else {
+            throw Py::TypeError("Target must be a mesh or a shape");
+        }
+
+        std::vector<MeshCore::MeshNearestPoint> nearest;
+        {
+            Base::PyGILStateRelease releaser{};
+            MeshCore::MeshFacetBVH tree(mesh->getKernel(), mesh->getTransform());
+            nearest = tree.NearestPoints(pointsIn, static_cast<float>(maxDist),
+                                         Base::asBoolean(signedDist));
+        }
+
+        Py::List list;
+        for (const auto& it : nearest) {
+            if (it.facet == MeshCore::FACET_INDEX_MAX) {
+                list.append(Py::None());
+                continue;
+            }
+
+            Py::Tuple weights(3);
+            weights.setItem(0, Py::Float(it.weights[0]));
+            weights.setItem(1, Py::Float(it.weights[1]));
+            weights.setItem(2, Py::Float(it.weights[2]));
+
+            Py::Tuple item(4);
+            item.setItem(0, Py::Float(it.distance));
+            item.setItem(1, Py::Long(static_cast<unsigned long>(it.facet)));
+            item.setItem(2, weights);
+            item.setItem(3, Py::Vector(Base::convertTo<Base::Vector3d>(it.point)));
+            list.append(item);
+        }
+
+        return list;
+    }
     Py::Object wireFromSegment(const Py::Tuple& args)
     {
         PyObject *o, *m;
@@ -640,6 +738,55 @@ private:
 
         throw Py::TypeError("Wrong arguments");
     }
+    Py::Object meshFromShapes(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *list;
+        double lindeflection=0;
+        double angdeflection=0.5;
+        PyObject* relative = Py_False;
+        PyObject* segment = Py_False;
+
+        static const std::array<const char *, 6> kwds_shapes{"Shapes", "LinearDeflection", "AngularDeflection",
+                                                             "Relative", "Segments", nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "Od|dO!O!", kwds_shapes,
+                                                 &list, &lindeflection, &angdeflection,
+                                                 &(PyBool_Type), &relative, &(PyBool_Type), &segment))
+            throw Py::Exception();
+
+        std::vector<TopoDS_Shape> shapes;
+        Py::Sequence seq(list);
+        for (Py::Sequence::iterator it = seq.begin(); it != seq.end(); ++it) {
+            PyObject* item = (*it).ptr();
+            if (!PyObject_TypeCheck(item, &(Part::TopoShapePy::Type)))
+                throw Py::TypeError("Shapes must be a list of shapes");
+            shapes.push_back(static_cast<Part::TopoShapePy*>(item)->getTopoShapePtr()->getShape());
+        }
+
+        std::vector<Mesh::MeshObject*> meshes;
+        std::vector<MeshPart::Mesher::FaceTiming> timings;
+        {
+            Base::PyGILStateRelease releaser{};
+            meshes = MeshPart::Mesher::createMeshes(shapes, lindeflection, angdeflection,
+                                                    Base::asBoolean(relative),
+                                                    Base::asBoolean(segment), timings);
+        }
+
+        Py::List meshList;
+        for (auto it : meshes) {
+            meshList.append(Py::asObject(new Mesh::MeshPy(it)));
+        }
+        Py::List timingList;
+        for (const auto& it : timings) {
+            Py::Tuple tuple(4);
+            tuple.setItem(0, Py::Long(static_cast<unsigned long>(it.shape)));
+            tuple.setItem(1, Py::Long(static_cast<unsigned long>(it.face)));
+            tuple.setItem(2, Py::Long(static_cast<unsigned long>(it.facets)));
+            tuple.setItem(3, Py::Float(it.seconds));
+            timingList.append(tuple);
+        }
+
+        return Py::TupleN(meshList, timingList);
+    }
 };
 
 PyObject* initModule()
@@ -25,6 +25,13 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include <QtConcurrentMap>
+
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
@@ -50,6 +57,7 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/FacetBVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -100,10 +108,34 @@ CurveProjectorShape::CurveProjectorShape(const TopoDS_Shape& aShape, const MeshK
 
 void CurveProjectorShape::Do()
 {
+    // search the start points of all edges at once
+    std::vector<TopoDS_Edge> edges;
+    std::vector<Base::Vector3f> startPoints;
     TopExp_Explorer Ex;
     for (Ex.Init(_Shape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
         const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        projectCurve(aEdge, mvEdgeSplitPoints[aEdge]);
+        // every edge gets an entry, also if it cannot be projected
+        mvEdgeSplitPoints.try_emplace(aEdge);
+        Standard_Real fFirst, fLast;
+        Handle(Geom_Curve) hCurve = BRep_Tool::Curve(aEdge, fFirst, fLast);
+        if (hCurve.IsNull()) {
+            continue;
+        }
+
+        gp_Pnt gpPt = hCurve->Value(fFirst);
+        edges.push_back(aEdge);
+        startPoints.emplace_back((float)gpPt.X(), (float)gpPt.Y(), (float)gpPt.Z());
+    }
+
+    CurveProjectorBatch projector(_Mesh);
+    std::vector<MeshCore::MeshNearestPoint> startFacets =
+        projector.nearestPoints(startPoints, FLOAT_MAX);
+
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        std::vector<FaceSplitEdge>& vSplitEdges = mvEdgeSplitPoints[edges[i]];
+        if (startFacets[i].facet != MeshCore::FACET_INDEX_MAX) {
+            projectCurve(edges[i], startFacets[i].point, startFacets[i].facet, vSplitEdges);
+        }
     }
 }
 
@@ -119,17 +151,32 @@ void CurveProjectorShape::projectCurve(const TopoDS_Edge& aEdge,
 
     // projection of the first point
     Base::Vector3f cStartPoint = Base::Vector3f((float)gpPt.X(), (float)gpPt.Y(), (float)gpPt.Z());
-    Base::Vector3f cResultPoint, cSplitPoint, cPlanePnt, cPlaneNormal;
-    MeshCore::FacetIndex uStartFacetIdx, uCurFacetIdx;
-    MeshCore::FacetIndex uLastFacetIdx =
-        MeshCore::FACET_INDEX_MAX - 1;  // use another value as FACET_INDEX_MAX
-    MeshCore::FacetIndex auNeighboursIdx[3];
-    bool GoOn;
+    Base::Vector3f cResultPoint;
+    MeshCore::FacetIndex uStartFacetIdx;
 
     if (!findStartPoint(_Mesh, cStartPoint, cResultPoint, uStartFacetIdx)) {
         return;
     }
 
+    projectCurve(aEdge, cResultPoint, uStartFacetIdx, vSplitEdges);
+}
+
+void CurveProjectorShape::projectCurve(const TopoDS_Edge& aEdge,
+                                       const Base::Vector3f& cStartPoint,
+                                       MeshCore::FacetIndex uStartFacetIdx,
+                                       std::vector<FaceSplitEdge>& vSplitEdges)
+{
+    Standard_Real fFirst, fLast;
+    Handle(Geom_Curve) hCurve = BRep_Tool::Curve(aEdge, fFirst, fLast);
+
+    Base::Vector3f cResultPoint = cStartPoint;
+    Base::Vector3f cSplitPoint, cPlanePnt, cPlaneNormal;
+    MeshCore::FacetIndex uCurFacetIdx;
+    MeshCore::FacetIndex uLastFacetIdx =
+        MeshCore::FACET_INDEX_MAX - 1;  // use another value as FACET_INDEX_MAX
+    MeshCore::FacetIndex auNeighboursIdx[3];
+    bool GoOn;
+
     uCurFacetIdx = uStartFacetIdx;
     do {
         MeshGeomFacet cCurFacet = _Mesh.GetFacet(uCurFacetIdx);
@@ -274,11 +321,20 @@ void CurveProjectorSimple::Do()
 {
     TopExp_Explorer Ex;
 
-    std::vector<Base::Vector3f> vEdgePolygon;
-
+    std::vector<TopoDS_Edge> edges;
     for (Ex.Init(_Shape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        projectCurve(aEdge, vEdgePolygon, mvEdgeSplitPoints[aEdge]);
+        edges.push_back(TopoDS::Edge(Ex.Current()));
+    }
+
+    CurveProjectorBatch projector(_Mesh);
+    std::vector<std::vector<CurveProjectorBatch::Path>> paths =
+        projector.project(edges, FLOAT_MAX);
+
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        std::vector<FaceSplitEdge>& vSplitEdges = mvEdgeSplitPoints[edges[i]];
+        for (const auto& it : paths[i]) {
+            vSplitEdges.insert(vSplitEdges.end(), it.begin(), it.end());
+        }
     }
 }
 
@@ -631,31 +687,27 @@ void MeshProjection::projectToMesh(const TopoDS_Shape& aShape,
                                    float fMaxDist,
                                    std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
-
     TopExp_Explorer Ex;
 
-    int iCnt = 0;
+    std::vector<TopoDS_Edge> edges;
     for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        iCnt++;
+        edges.push_back(TopoDS::Edge(Ex.Current()));
     }
 
-    Base::SequencerLauncher seq("Project curve on mesh", iCnt);
-
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        std::vector<SplitEdge> rSplitEdges;
-        projectEdgeToEdge(aEdge, fMaxDist, cGrid, rSplitEdges);
-        PolyLine polyline;
-        polyline.points.reserve(rSplitEdges.size());
-        for (auto it : rSplitEdges) {
-            polyline.points.push_back(it.cPt);
+    CurveProjectorBatch projector(_rcMesh);
+    std::vector<std::vector<CurveProjectorBatch::Path>> paths = projector.project(edges, fMaxDist);
+
+    // a curve that leaves the mesh is split into several paths, each one gives a polyline
+    for (const auto& it : paths) {
+        for (const auto& jt : it) {
+            // two consecutive segments of a path meet on an edge of the mesh
+            PolyLine polyline;
+            polyline.points.reserve(jt.size());
+            for (std::size_t i = 1; i < jt.size(); i++) {
+                polyline.points.push_back(jt[i].p1);
+            }
+            rPolyLines.push_back(polyline);
         }
-        rPolyLines.push_back(polyline);
-        seq.next();
     }
 }
 
@@ -852,150 +904,263 @@ void MeshProjection::projectParallelToMesh(const std::vector<PolyLine>& aEdges,
     }
 }
 
-void MeshProjection::projectEdgeToEdge(const TopoDS_Edge& aEdge,
-                                       float fMaxDist,
-                                       const MeshFacetGrid& rGrid,
-                                       std::vector<SplitEdge>& rSplitEdges) const
+// ----------------------------------------------------------------------------
+
+namespace
 {
-    std::vector<MeshCore::FacetIndex> auFInds;
-    std::map<std::pair<MeshCore::PointIndex, MeshCore::PointIndex>, std::list<MeshCore::FacetIndex>>
-        pEdgeToFace;
-    const std::vector<MeshFacet>& rclFAry = _rcMesh.GetFacets();
-
-    // search the facets in the local area of the curve
-    std::vector<Base::Vector3f> acPolyLine;
-    discretize(aEdge, acPolyLine);
-
-    MeshAlgorithm(_rcMesh).SearchFacetsFromPolyline(acPolyLine, fMaxDist, rGrid, auFInds);
-    // remove duplicated elements
-    std::sort(auFInds.begin(), auFInds.end());
-    auFInds.erase(std::unique(auFInds.begin(), auFInds.end()), auFInds.end());
-
-    // facet to edge
-    for (MeshCore::FacetIndex index : auFInds) {
-        const MeshFacet& rF = rclFAry[index];
-        for (int i = 0; i < 3; i++) {
-            MeshCore::PointIndex ulPt0 =
-                std::min<MeshCore::PointIndex>(rF._aulPoints[i], rF._aulPoints[(i + 1) % 3]);
-            MeshCore::PointIndex ulPt1 =
-                std::max<MeshCore::PointIndex>(rF._aulPoints[i], rF._aulPoints[(i + 1) % 3]);
-            pEdgeToFace[std::pair<MeshCore::PointIndex, MeshCore::PointIndex>(ulPt0, ulPt1)]
-                .push_front(index);
+// maximum number of bisections to connect two samples on non-adjacent facets
+constexpr int maxStitchDepth = 8;
+
+struct EdgeSampling
+{
+    const TopoDS_Edge* edge;
+    float avgLength;
+    std::vector<Base::Vector3f> points;
+};
+
+struct PathStitching
+{
+    std::size_t begin;
+    std::size_t end;
+    std::vector<CurveProjectorBatch::Path> paths;
+};
+
+/*
+ * Connects the projected samples of a curve to paths over the mesh.
+ */
+class PathStitcher
+{
+public:
+    PathStitcher(const MeshKernel& mesh, const MeshCore::MeshFacetBVH& bvh, float maxDist)
+        : mesh(mesh)
+        , bvh(bvh)
+        , maxDist(maxDist)
+    {}
+
+    std::vector<CurveProjectorBatch::Path> stitch(const Base::Vector3f* samples,
+                                                  const MeshCore::MeshNearestPoint* hits,
+                                                  std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            if (hits[i].facet == MeshCore::FACET_INDEX_MAX) {
+                closePath();
+            }
+            else if (facet == MeshCore::FACET_INDEX_MAX) {
+                startPath(hits[i]);
+            }
+            else {
+                walk(samples[i - 1], samples[i], hits[i], 0);
+            }
         }
+
+        closePath();
+        return std::move(paths);
     }
 
-    // sort intersection points by parameter
-    std::map<Standard_Real, SplitEdge> rParamSplitEdges;
+private:
+    void startPath(const MeshCore::MeshNearestPoint& hit)
+    {
+        facet = hit.facet;
+        entry = hit.point;
+        last = hit.point;
+    }
 
-    BRepAdaptor_Curve clCurve(aEdge);
-    Standard_Real fFirst = clCurve.FirstParameter();
-    Standard_Real fLast = clCurve.LastParameter();
-    Handle(Geom_Curve) hCurve = BRep_Tool::Curve(aEdge, fFirst, fLast);
+    void closePath()
+    {
+        if (facet == MeshCore::FACET_INDEX_MAX) {
+            return;
+        }
 
-    MeshPointIterator cPI(_rcMesh);
-    MeshFacetIterator cFI(_rcMesh);
+        if (!path.empty() || entry != last) {
+            path.push_back({facet, entry, last});
+        }
+        if (!path.empty()) {
+            paths.push_back(std::move(path));
+            path.clear();
+        }
+        facet = MeshCore::FACET_INDEX_MAX;
+    }
 
-    Base::SequencerLauncher seq("Project curve on mesh", pEdgeToFace.size());
-    std::map<std::pair<MeshCore::PointIndex, MeshCore::PointIndex>,
-             std::list<MeshCore::FacetIndex>>::iterator it;
-    for (it = pEdgeToFace.begin(); it != pEdgeToFace.end(); ++it) {
-        seq.next();
+    void crossTo(const Base::Vector3f& pnt, const MeshCore::MeshNearestPoint& hit)
+    {
+        path.push_back({facet, entry, pnt});
+        facet = hit.facet;
+        entry = pnt;
+        last = hit.point;
+    }
 
-        // edge points
-        MeshCore::PointIndex uE0 = it->first.first;
-        cPI.Set(uE0);
-        Base::Vector3f cE0 = *cPI;
-        MeshCore::PointIndex uE1 = it->first.second;
-        cPI.Set(uE1);
-        Base::Vector3f cE1 = *cPI;
-
-        const std::list<MeshCore::FacetIndex>& auFaces = it->second;
-        if (auFaces.size() > 2) {
-            continue;  // non-manifold edge -> don't handle this
-        }
-
-        Base::Vector3f cEdgeNormal;
-        for (MeshCore::FacetIndex itF : auFaces) {
-            cFI.Set(itF);
-            cEdgeNormal += cFI->GetNormal();
-        }
-
-        // create a plane from the edge normal and point
-        Base::Vector3f cPlaneNormal = cEdgeNormal % (cE1 - cE0);
-        Handle(Geom_Plane) hPlane =
-            new Geom_Plane(gp_Pln(gp_Pnt(cE0.x, cE0.y, cE0.z),
-                                  gp_Dir(cPlaneNormal.x, cPlaneNormal.y, cPlaneNormal.z)));
-
-        // get intersection of curve and plane
-        GeomAPI_IntCS Alg(hCurve, hPlane);
-        if (Alg.IsDone()) {
-            Standard_Integer nNbPoints = Alg.NbPoints();
-            if (nNbPoints == 1) {
-                Standard_Real fU, fV, fW;
-                Alg.Parameters(1, fU, fV, fW);
-
-                gp_Pnt P = Alg.Point(1);
-                Base::Vector3f cP0((float)P.X(), (float)P.Y(), (float)P.Z());
-
-                float l = ((cP0 - cE0) * (cE1 - cE0)) / ((cE1 - cE0) * (cE1 - cE0));
-
-                // lies the point inside the edge?
-                if (l >= 0.0f && l <= 1.0f) {
-                    Base::Vector3f cSplitPoint = (1 - l) * cE0 + l * cE1;
-                    float fDist = Base::Distance(cP0, cSplitPoint);
-
-                    if (fDist <= fMaxDist) {
-                        SplitEdge splitEdge;
-                        splitEdge.uE0 = uE0;
-                        splitEdge.uE1 = uE1;
-                        splitEdge.cPt = cSplitPoint;
-                        rParamSplitEdges[fW] = splitEdge;
-                    }
-                }
+    // continues the path from the last projected sample to the projection \a hit of \a to
+    void walk(const Base::Vector3f& from,
+              const Base::Vector3f& to,
+              const MeshCore::MeshNearestPoint& hit,
+              int depth)
+    {
+        if (hit.facet == facet) {
+            last = hit.point;
+            return;
+        }
+
+        const MeshFacet& curr = mesh.GetFacets()[facet];
+        unsigned short side = curr.Side(hit.facet);
+        if (side < 3) {
+            crossTo(crossing(last, hit.point, side, hit.facet), hit);
+            return;
+        }
+
+        if (depth < maxStitchDepth) {
+            Base::Vector3f mid = 0.5f * (from + to);
+            MeshCore::MeshNearestPoint midHit;
+            if (bvh.NearestPoint(mid, maxDist, false, midHit)) {
+                walk(from, mid, midHit, depth + 1);
+                walk(mid, to, hit, depth + 1);
+                return;
             }
-            // search for the right solution
-            else if (nNbPoints > 1) {
-                int nCntSol = 0;
-                Base::Vector3f cSplitPoint;
-                Standard_Real fSol;
-                Base::Vector3f cP0;
-                for (int j = 1; j <= nNbPoints; j++) {
-                    Standard_Real fU, fV, fW;
-                    Alg.Parameters(j, fU, fV, fW);
-                    gp_Pnt P = Alg.Point(j);
-                    cP0.Set((float)P.X(), (float)P.Y(), (float)P.Z());
-
-                    float l = ((cP0 - cE0) * (cE1 - cE0)) / ((cE1 - cE0) * (cE1 - cE0));
-
-                    // lies the point inside the edge?
-                    if (l >= 0.0 && l <= 1.0) {
-                        cSplitPoint = (1 - l) * cE0 + l * cE1;
-                        float fDist = Base::Distance(cP0, cSplitPoint);
-
-                        if (fDist <= fMaxDist) {
-                            nCntSol++;
-                            fSol = fW;
-                        }
-                    }
-                }
+        }
 
-                // ok, only one sensible solution
-                if (nCntSol == 1) {
-                    SplitEdge splitEdge;
-                    splitEdge.uE0 = uE0;
-                    splitEdge.uE1 = uE1;
-                    splitEdge.cPt = cSplitPoint;
-                    rParamSplitEdges[fSol] = splitEdge;
-                }
-                else if (nCntSol > 1) {
-                    Base::Console().Log("More than one possible intersection points\n");
-                }
+        // the curve passes through a common point of both facets
+        const MeshFacet& next = mesh.GetFacets()[hit.facet];
+        for (MeshCore::PointIndex index : curr._aulPoints) {
+            if (next.HasPoint(index)) {
+                crossTo(mesh.GetPoint(index), hit);
+                return;
             }
         }
+
+        // the samples cannot be connected over the mesh
+        closePath();
+        startPath(hit);
     }
 
-    // sorted by parameter
-    for (const auto& itS : rParamSplitEdges) {
-        rSplitEdges.push_back(itS.second);
+    // intersects the segment (p1, p2) with the edge \a side of the current facet
+    Base::Vector3f crossing(const Base::Vector3f& p1,
+                            const Base::Vector3f& p2,
+                            unsigned short side,
+                            MeshCore::FacetIndex neighbour) const
+    {
+        const MeshFacet& curr = mesh.GetFacets()[facet];
+        Base::Vector3f e0 = mesh.GetPoint(curr._aulPoints[side]);
+        Base::Vector3f e1 = mesh.GetPoint(curr._aulPoints[(side + 1) % 3]);
+        Base::Vector3f edge = e1 - e0;
+        if (edge.Sqr() == 0.0f) {
+            return e0;
+        }
+
+        // the plane through the segment that contains the common normal of both facets
+        Base::Vector3f normal = mesh.GetFacet(facet).GetNormal();
+        normal += mesh.GetFacet(neighbour).GetNormal();
+        Base::Vector3f planeNormal = (p2 - p1) % normal;
+
+        float dist0 = planeNormal * (e0 - p1);
+        float dist1 = planeNormal * (e1 - p1);
+        float t {};
+        if (std::fabs(dist0 - dist1) > FLT_EPSILON * planeNormal.Length() * edge.Length()) {
+            t = dist0 / (dist0 - dist1);
+        }
+        else {
+            t = ((0.5f * (p1 + p2) - e0) * edge) / edge.Sqr();
+        }
+
+        t = std::clamp(t, 0.0f, 1.0f);
+        return e0 + t * edge;
     }
+
+    const MeshKernel& mesh;
+    const MeshCore::MeshFacetBVH& bvh;
+    float maxDist;
+    std::vector<CurveProjectorBatch::Path> paths;
+    CurveProjectorBatch::Path path;
+    MeshCore::FacetIndex facet {MeshCore::FACET_INDEX_MAX};
+    Base::Vector3f entry;
+    Base::Vector3f last;
+};
+}  // namespace
+
+CurveProjectorBatch::CurveProjectorBatch(const MeshKernel& rMesh)
+    : _rcMesh(rMesh)
+    , _bvh(std::make_unique<MeshCore::MeshFacetBVH>(rMesh))
+{}
+
+CurveProjectorBatch::~CurveProjectorBatch() = default;
+
+std::vector<std::vector<CurveProjectorBatch::Path>>
+CurveProjectorBatch::project(const std::vector<TopoDS_Edge>& edges, float fMaxDist) const
+{
+    // sample the edges with a density that depends on the size of the facets
+    MeshAlgorithm clAlg(_rcMesh);
+    float fAvgLen = clAlg.GetAverageEdgeLength();
+
+    std::vector<EdgeSampling> samplings;
+    samplings.reserve(edges.size());
+    for (const auto& it : edges) {
+        samplings.push_back({&it, fAvgLen, {}});
+    }
+
+    // the steps run in parallel, so the progress is only reported between them
+    Base::SequencerLauncher seq("Project curve on mesh", 2);
+
+    MeshProjection meshProjection(_rcMesh);
+    QtConcurrent::blockingMap(samplings, [&meshProjection](EdgeSampling& sampling) {
+        try {
+            std::size_t minPoints = 10;
+            if (sampling.avgLength > 0.0f) {
+                BRepAdaptor_Curve adapt(*sampling.edge);
+                double edgeLen = GCPnts_AbscissaPoint::Length(adapt, Precision::Confusion());
+                minPoints = std::max<std::size_t>(
+                    minPoints,
+                    static_cast<std::size_t>(edgeLen / sampling.avgLength));
+            }
+            meshProjection.discretize(*sampling.edge, sampling.points, minPoints);
+        }
+        catch (const Standard_Failure&) {
+            sampling.points.clear();
+        }
+    });
+
+    std::vector<std::vector<Base::Vector3f>> curves;
+    curves.reserve(samplings.size());
+    for (auto& it : samplings) {
+        curves.push_back(std::move(it.points));
+    }
+    seq.next();
+
+    std::vector<std::vector<Path>> paths = project(curves, fMaxDist);
+    seq.next();
+    return paths;
+}
+
+std::vector<std::vector<CurveProjectorBatch::Path>>
+CurveProjectorBatch::project(const std::vector<std::vector<Base::Vector3f>>& curves,
+                             float fMaxDist) const
+{
+    // project the samples of all curves at once
+    std::vector<Base::Vector3f> samples;
+    std::vector<PathStitching> stitchings;
+    stitchings.reserve(curves.size());
+    for (const auto& it : curves) {
+        std::size_t begin = samples.size();
+        samples.insert(samples.end(), it.begin(), it.end());
+        stitchings.push_back({begin, samples.size(), {}});
+    }
+
+    std::vector<MeshCore::MeshNearestPoint> hits = nearestPoints(samples, fMaxDist);
+
+    QtConcurrent::blockingMap(stitchings, [&](PathStitching& stitching) {
+        PathStitcher stitcher(_rcMesh, *_bvh, fMaxDist);
+        stitching.paths = stitcher.stitch(samples.data() + stitching.begin,
+                                          hits.data() + stitching.begin,
+                                          stitching.end - stitching.begin);
+    });
+
+    std::vector<std::vector<Path>> paths;
+    paths.reserve(stitchings.size());
+    for (auto& it : stitchings) {
+        paths.push_back(std::move(it.paths));
+    }
+    return paths;
+}
+
+std::vector<MeshCore::MeshNearestPoint>
+CurveProjectorBatch::nearestPoints(const std::vector<Base::Vector3f>& points, float fMaxDist) const
+{
+    return _bvh->NearestPoints(points, fMaxDist);
 }
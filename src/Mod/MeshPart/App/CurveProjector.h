@@ -23,6 +23,9 @@
 #ifndef _CurveProjector_h_
 #define _CurveProjector_h_
 
+#include <memory>
+#include <vector>
+
 #include <TopoDS_Edge.hxx>
 
 #include <Mod/Mesh/App/Mesh.h>
@@ -34,7 +37,8 @@ namespace MeshCore
 {
 class MeshKernel;
 class MeshGeomFacet;
-class MeshFacetGrid;
+class MeshFacetBVH;
+struct MeshNearestPoint;
 }  // namespace MeshCore
 
 using MeshCore::MeshGeomFacet;
@@ -98,6 +102,11 @@ public:
     ~CurveProjectorShape() override = default;
 
     void projectCurve(const TopoDS_Edge& aEdge, std::vector<FaceSplitEdge>& vSplitEdges);
+    /// Projects the curve starting at the point \a cStartPoint of the facet \a uStartFacetIdx
+    void projectCurve(const TopoDS_Edge& aEdge,
+                      const Base::Vector3f& cStartPoint,
+                      MeshCore::FacetIndex uStartFacetIdx,
+                      std::vector<FaceSplitEdge>& vSplitEdges);
 
     bool findStartPoint(const MeshKernel& MeshK,
                         const Base::Vector3f& Pnt,
@@ -207,6 +216,7 @@ public:
      * Searches all edges that intersect with the projected curve \a aShape. Therefore \a aShape
      * must contain shapes of type TopoDS_Edge, other shape types are ignored. A possible solution
      * is taken if the distance between the curve point and the projected point is <= \a fMaxDist.
+     * The edges are projected at once with CurveProjectorBatch.
      */
     void projectToMesh(const TopoDS_Shape& aShape,
                        float fMaxDist,
@@ -244,10 +254,6 @@ public:
     void splitMeshByShape(const TopoDS_Shape& aShape, float fMaxDist) const;
 
 protected:
-    void projectEdgeToEdge(const TopoDS_Edge& aCurve,
-                           float fMaxDist,
-                           const MeshCore::MeshFacetGrid& rGrid,
-                           std::vector<SplitEdge>& rSplitEdges) const;
     bool findIntersection(const Edge&,
                           const Edge&,
                           const Base::Vector3f& dir,
@@ -257,6 +263,44 @@ private:
     const MeshKernel& _rcMesh;
 };
 
+/**
+ * The CurveProjectorBatch class projects many curves onto a mesh at once.
+ * All curves are sampled first, then the closest points of all samples are searched in
+ * parallel with a MeshFacetBVH. Afterwards the projected samples of each curve are
+ * stitched to paths over the mesh that are split where they cross an edge of the mesh.
+ * Samples that lie on facets without a common edge are connected by bisecting the curve.
+ */
+class MeshPartExport CurveProjectorBatch
+{
+public:
+    /// A connected part of a projected curve, consecutive segments meet on a mesh edge
+    using Path = std::vector<CurveProjector::FaceSplitEdge>;
+
+    explicit CurveProjectorBatch(const MeshKernel& rMesh);
+    ~CurveProjectorBatch();
+
+    /**
+     * Samples and projects all \a edges. Samples with a distance > \a fMaxDist to the mesh
+     * are ignored and interrupt the path of their edge. Returns the paths for each edge.
+     */
+    std::vector<std::vector<Path>> project(const std::vector<TopoDS_Edge>& edges,
+                                           float fMaxDist) const;
+    /**
+     * Projects already sampled curves. @see project() for more details.
+     */
+    std::vector<std::vector<Path>> project(const std::vector<std::vector<Base::Vector3f>>& curves,
+                                           float fMaxDist) const;
+    /**
+     * Searches the closest points on the mesh of all \a points within \a fMaxDist.
+     */
+    std::vector<MeshCore::MeshNearestPoint> nearestPoints(const std::vector<Base::Vector3f>& points,
+                                                          float fMaxDist) const;
+
+private:
+    const MeshKernel& _rcMesh;
+    std::unique_ptr<MeshCore::MeshFacetBVH> _bvh;
+};
+
 }  // namespace MeshPart
 
 #endif
@@ -196,6 +196,10 @@ struct eigen_matrix
 
 BOOST_PYTHON_MODULE(flatmesh)
 {
+    py::enum_<lscmrelax::LscmRelax::Solver>("LscmRelaxSolver")
+        .value("Direct", lscmrelax::LscmRelax::Solver::Direct)
+        .value("Iterative", lscmrelax::LscmRelax::Solver::Iterative);
+
     py::class_<lscmrelax::LscmRelax>("LscmRelax")
         .def(py::init<ColMat<double, 3>, ColMat<long, 3>, std::vector<long>>())
         .def("lscm", &lscmrelax::LscmRelax::lscm)
@@ -204,6 +208,8 @@ BOOST_PYTHON_MODULE(flatmesh)
         .def("transform", &lscmrelax::LscmRelax::transform)
         .def_readonly("rhs", &lscmrelax::LscmRelax::rhs)
         .def_readonly("MATRIX", &lscmrelax::LscmRelax::MATRIX)
+        .def_readwrite("lscm_solver", &lscmrelax::LscmRelax::lscm_solver)
+        .def_readwrite("relax_solver", &lscmrelax::LscmRelax::relax_solver)
         .def_readonly("area", &lscmrelax::LscmRelax::get_area)
         .def_readonly("flat_area", &lscmrelax::LscmRelax::get_flat_area)
         .def_readonly("flat_vertices_3D", &lscmrelax::LscmRelax::get_flat_vertices_3D);
@@ -22,12 +22,17 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
 #include <map>
 #include <set>
+#include <stdexcept>
+#include <thread>
 #include <vector>
+
+#include <QtConcurrentMap>
 #endif
 
 #ifndef M_PI
@@ -51,6 +56,38 @@ using trip = Eigen::Triplet<double>;
 using spMat = Eigen::SparseMatrix<double>;
 
 
+// calls func(i) for i in [0, count), large ranges are split into blocks running in parallel
+template<typename Func>
+void parallel_for(long count, const Func& func)
+{
+    struct Range
+    {
+        long begin;
+        long end;
+    };
+
+    const long min_block_size = 4096;
+    const long num_threads = std::max(1U, std::thread::hardware_concurrency());
+    const long num_blocks = std::min(4 * num_threads, count / min_block_size);
+    if (num_blocks < 2)
+    {
+        for (long i=0; i < count; i++)
+            func(i);
+        return;
+    }
+
+    std::vector<Range> ranges;
+    ranges.reserve(num_blocks);
+    for (long i=0; i < num_blocks; i++)
+        ranges.push_back({i * count / num_blocks, (i + 1) * count / num_blocks});
+
+    QtConcurrent::blockingMap(ranges, [&func](const Range& range) {
+        for (long i=range.begin; i < range.end; i++)
+            func(i);
+    });
+}
+
+
 
 ColMat<double, 2> map_to_2D(ColMat<double, 3> points)
 {
@@ -148,24 +185,25 @@ LscmRelax::LscmRelax(
 void LscmRelax::relax(double weight)
 {
     ColMat<double, 3> d_q_l_g = this->q_l_m - this->q_l_g;
-    // for every triangle
-    Eigen::Matrix<double, 3, 6> B;
-    Eigen::Matrix<double, 2, 2> T;
-    Eigen::Matrix<double, 6, 6> K_m;
-    Eigen::Matrix<double, 6, 1> u_m, rhs_m;
     Eigen::VectorXd rhs(this->vertices.cols() * 2 + 3);
-    if (this->sol.size() == 0)
-        this->sol.Zero(this->vertices.cols() * 2 + 3);
     spMat K_g(this->vertices.cols() * 2 + 3, this->vertices.cols() * 2 + 3);
-    std::vector<trip> K_g_triplets;
-    Vector2 v1, v2, v3, v12, v23, v31;
-    long row_pos, col_pos;
-    double A;
+    // every triangle writes its 36 entries to its own slots, so they can be computed in parallel
+    std::vector<trip> K_g_triplets(this->triangles.cols() * 36);
+    std::vector<Eigen::Matrix<double, 6, 1>> rhs_triangles(this->triangles.cols());
 
     rhs.setZero();
 
-    for (long i=0; i<this->triangles.cols(); i++)
+    // for every triangle
+    parallel_for(this->triangles.cols(), [&](long i)
     {
+        Eigen::Matrix<double, 3, 6> B;
+        Eigen::Matrix<double, 2, 2> T;
+        Eigen::Matrix<double, 6, 6> K_m;
+        Eigen::Matrix<double, 6, 1> u_m;
+        Vector2 v1, v2, v3, v12, v23, v31;
+        long row_pos, col_pos;
+        double A;
+
         // 1: construct B-mat in m-system
         v1 = this->flat_vertices.col(this->triangles(0, i));
         v2 = this->flat_vertices.col(this->triangles(1, i));
@@ -187,25 +225,35 @@ void LscmRelax::relax(double weight)
 
         // 3: rhs_m = B.T * C * B * dqlg_m
         //    K_m = B.T * C * B
-        rhs_m = B.transpose() * this->C * B * u_m * A;
+        rhs_triangles[i] = B.transpose() * this->C * B * u_m * A;
         K_m = B.transpose() * this->C * B * A;
 
-        // 5: add to rhs_g, K_g
+        // 5: add to K_g
+        auto triplet = K_g_triplets.begin() + i * 36;
         for (int j=0; j < 3; j++)
         {
             row_pos = this->triangles(j, i);
-            rhs[row_pos * 2]     += rhs_m[j * 2];
-            rhs[row_pos * 2 + 1] += rhs_m[j * 2 +1];
             for (int k=0; k < 3; k++)
             {
                 col_pos = this->triangles(k, i);
-                K_g_triplets.emplace_back(trip(row_pos * 2,     col_pos * 2,        K_m(j * 2,      k * 2)));
-                K_g_triplets.emplace_back(trip(row_pos * 2 + 1, col_pos * 2,        K_m(j * 2 + 1,  k * 2)));
-                K_g_triplets.emplace_back(trip(row_pos * 2 + 1, col_pos * 2 + 1,    K_m(j * 2 + 1,  k * 2 + 1)));
-                K_g_triplets.emplace_back(trip(row_pos * 2,     col_pos * 2 + 1,    K_m(j * 2,      k * 2 + 1)));
+                *triplet++ = trip(row_pos * 2,     col_pos * 2,        K_m(j * 2,      k * 2));
+                *triplet++ = trip(row_pos * 2 + 1, col_pos * 2,        K_m(j * 2 + 1,  k * 2));
+                *triplet++ = trip(row_pos * 2 + 1, col_pos * 2 + 1,    K_m(j * 2 + 1,  k * 2 + 1));
+                *triplet++ = trip(row_pos * 2,     col_pos * 2 + 1,    K_m(j * 2,      k * 2 + 1));
                 // we don't have to fill all because the matrix is symmetric.
             }
         }
+    });
+
+    // 5: add to rhs_g (in a fixed order to get reproducible results)
+    for (long i=0; i<this->triangles.cols(); i++)
+    {
+        for (int j=0; j < 3; j++)
+        {
+            long row_pos = this->triangles(j, i);
+            rhs[row_pos * 2]     += rhs_triangles[i][j * 2];
+            rhs[row_pos * 2 + 1] += rhs_triangles[i][j * 2 + 1];
+        }
     }
     // FIXING SOME PINS:
     // - if there are no pins (or only one pin) selected solve the system without the nullspace solution.
@@ -286,13 +334,46 @@ void LscmRelax::relax(double weight)
     // rhs +=  K_g * Eigen::VectorXd::Ones(K_g.rows());
 
     // solve linear system (privately store the value for guess in next step)
-    Eigen::SimplicialLDLT<spMat, Eigen::Lower> solver;
-    solver.compute(K_g);
-    this->sol = solver.solve(-rhs);
+    if (this->relax_solver == Solver::Direct || !this->relax_iterative(K_g, rhs))
+        this->relax_direct(K_g, rhs);
     this->set_shift(this->sol.head(this->vertices.cols() * 2) * weight);
     this->set_q_l_m();
 }
 
+bool LscmRelax::relax_iterative(const spMat& K_g, const Eigen::VectorXd& rhs)
+{
+    // BiCGSTAB may break down or not converge, in this case the caller
+    // falls back to the direct solver
+    Eigen::VectorXd guess = this->sol;
+    if (guess.size() != rhs.size())
+        guess.setZero(rhs.size());
+    Eigen::BiCGSTAB<spMat, Eigen::IncompleteLUT<double>> solver;
+    solver.compute(K_g);
+    if (solver.info() != Eigen::Success)
+        return false;
+    Eigen::VectorXd result = solver.solveWithGuess(-rhs, guess);
+    if (solver.info() != Eigen::Success)
+        return false;
+    this->sol = result;
+    return true;
+}
+
+void LscmRelax::relax_direct(const spMat& K_g, const Eigen::VectorXd& rhs)
+{
+    auto& ldlt = this->relax_ldlt.ldlt;
+    if (!ldlt || ldlt->rows() != K_g.rows())
+    {
+        ldlt = std::make_unique<Eigen::SimplicialLDLT<spMat, Eigen::Lower>>();
+        ldlt->analyzePattern(K_g);
+    }
+    ldlt->factorize(K_g);
+    if (ldlt->info() != Eigen::Success)
+        throw std::runtime_error("relax: factorization of the stiffness matrix failed");
+    Eigen::VectorXd result = ldlt->solve(-rhs);
+    if (ldlt->info() != Eigen::Success)
+        throw std::runtime_error("relax: solving the linear system failed");
+    this->sol = result;
+}
 
 void LscmRelax::area_relax(double weight)
 {
@@ -425,31 +506,30 @@ void LscmRelax::edge_relax(double weight)
 void LscmRelax::lscm()
 {
     this->set_q_l_g();
-    std::vector<trip> triple_list;
-    long i;
-    double x21, x31, y31, x32;
+    // every triangle writes its 10 entries to its own slots
+    std::vector<trip> triple_list(this->triangles.cols() * 10);
 
     // 1. create the triplet list (t * 2, v * 2)
-    for(i=0; i<this->triangles.cols(); i++)
+    parallel_for(this->triangles.cols(), [&](long i)
     {
-        x21 = this->q_l_g(i, 0);
-        x31 = this->q_l_g(i, 1);
-        y31 = this->q_l_g(i, 2);
-        x32 = x31 - x21;
-
-        triple_list.emplace_back(trip(2 * i, this->new_order[this->triangles(0, i)] * 2, x32));
-        triple_list.emplace_back(trip(2 * i, this->new_order[this->triangles(0, i)] * 2 + 1, -y31));
-        triple_list.emplace_back(trip(2 * i, this->new_order[this->triangles(1, i)] * 2, -x31));
-        triple_list.emplace_back(trip(2 * i, this->new_order[this->triangles(1, i)] * 2 + 1, y31));
-        triple_list.emplace_back(trip(2 * i, this->new_order[this->triangles(2, i)] * 2, x21));
-
-        triple_list.emplace_back(trip(2 * i + 1, this->new_order[this->triangles(0, i)] * 2, y31));
-        triple_list.emplace_back(trip(2 * i + 1, this->new_order[this->triangles(0, i)] * 2 + 1, x32));
-        triple_list.emplace_back(trip(2 * i + 1, this->new_order[this->triangles(1, i)] * 2, -y31));
-        triple_list.emplace_back(trip(2 * i + 1, this->new_order[this->triangles(1, i)] * 2 + 1, -x31));
-        triple_list.emplace_back(trip(2 * i + 1, this->new_order[this->triangles(2, i)] * 2 + 1, x21));
-
-    }
+        double x21 = this->q_l_g(i, 0);
+        double x31 = this->q_l_g(i, 1);
+        double y31 = this->q_l_g(i, 2);
+        double x32 = x31 - x21;
+
+        auto triplet = triple_list.begin() + i * 10;
+        *triplet++ = trip(2 * i, this->new_order[this->triangles(0, i)] * 2, x32);
+        *triplet++ = trip(2 * i, this->new_order[this->triangles(0, i)] * 2 + 1, -y31);
+        *triplet++ = trip(2 * i, this->new_order[this->triangles(1, i)] * 2, -x31);
+        *triplet++ = trip(2 * i, this->new_order[this->triangles(1, i)] * 2 + 1, y31);
+        *triplet++ = trip(2 * i, this->new_order[this->triangles(2, i)] * 2, x21);
+
+        *triplet++ = trip(2 * i + 1, this->new_order[this->triangles(0, i)] * 2, y31);
+        *triplet++ = trip(2 * i + 1, this->new_order[this->triangles(0, i)] * 2 + 1, x32);
+        *triplet++ = trip(2 * i + 1, this->new_order[this->triangles(1, i)] * 2, -y31);
+        *triplet++ = trip(2 * i + 1, this->new_order[this->triangles(1, i)] * 2 + 1, -x31);
+        *triplet++ = trip(2 * i + 1, this->new_order[this->triangles(2, i)] * 2 + 1, x21);
+    });
     // 2. divide the triplets in matrix(unknown part) and rhs(known part) and reset the position
     std::vector<trip> rhs_triplets;
     std::vector<trip> mat_triplets;
@@ -482,10 +562,28 @@ void LscmRelax::lscm()
 
     // 6. solve the system and set the flatted coordinates
     // Eigen::SparseQR<spMat, Eigen::COLAMDOrdering<int> > solver;
-    Eigen::LeastSquaresConjugateGradient<spMat > solver;
     Eigen::VectorXd sol(this->vertices.size() * 2);
-    solver.compute(A);
-    sol = solver.solve(-rhs);
+    bool solved = false;
+    if (this->lscm_solver == Solver::Iterative)
+    {
+        Eigen::LeastSquaresConjugateGradient<spMat > solver;
+        solver.compute(A);
+        sol = solver.solve(-rhs);
+        // fall back to the direct solver if it didn't converge
+        solved = solver.info() == Eigen::Success;
+    }
+    if (!solved)
+    {
+        // normal equations of the least squares problem
+        spMat AtA = spMat(A.transpose()) * A;
+        Eigen::SimplicialLDLT<spMat> solver;
+        solver.compute(AtA);
+        if (solver.info() != Eigen::Success)
+            throw std::runtime_error("lscm: factorization of the normal equations failed");
+        sol = solver.solve(-(A.transpose() * rhs));
+        if (solver.info() != Eigen::Success)
+            throw std::runtime_error("lscm: solving the linear system failed");
+    }
 
     // TODO: create function, is needed also in the fem step
     this->set_position(sol);
@@ -502,7 +600,7 @@ void LscmRelax::set_q_l_g()
     // x1, y1, y2 = 0
     // -> vector<x2, x3, y3>
     this->q_l_g.resize(this->triangles.cols(), 3);
-    for (long i = 0; i < this->triangles.cols(); i++)
+    parallel_for(this->triangles.cols(), [this](long i)
     {
         Vector3 r1 = this->vertices.col(this->triangles(0, i));
         Vector3 r2 = this->vertices.col(this->triangles(1, i));
@@ -513,7 +611,7 @@ void LscmRelax::set_q_l_g()
         r21.normalize();
         // if triangle is flipped this gives wrong results?
         this->q_l_g.row(i) << r21_norm, r31.dot(r21), r31.cross(r21).norm();
-    }
+    });
 }
 
 void LscmRelax::set_q_l_m()
@@ -522,7 +620,7 @@ void LscmRelax::set_q_l_m()
     // x1, y1, y2 = 0
     // -> vector<x2, x3, y3>
     this->q_l_m.resize(this->triangles.cols(), 3);
-    for (long i = 0; i < this->triangles.cols(); i++)
+    parallel_for(this->triangles.cols(), [this](long i)
     {
         Vector2 r1 = this->flat_vertices.col(this->triangles(0, i));
         Vector2 r2 = this->flat_vertices.col(this->triangles(1, i));
@@ -533,7 +631,7 @@ void LscmRelax::set_q_l_m()
         r21.normalize();
         // if triangle is flipped this gives wrong results!
         this->q_l_m.row(i) << r21_norm, r31.dot(r21), -(r31.x() * r21.y() - r31.y() * r21.x());
-    }
+    });
 }
 
 void LscmRelax::set_fixed_pins()
@@ -40,6 +40,8 @@
 #include <tuple>
 #include <vector>
 
+#include <Eigen/SparseCholesky>
+
 #include "MeshFlattening.h"
 
 
@@ -89,7 +91,36 @@ private:
     std::vector<long> get_fem_fixed_pins();
     Eigen::MatrixXd get_nullspace();
 
+    // the pattern of the relax system only depends on the triangles, so its
+    // symbolic factorization is computed once per instance. A copy starts
+    // without it, because factorize() modifies the cached solver.
+    struct RelaxFactorization
+    {
+        RelaxFactorization() = default;
+        RelaxFactorization(const RelaxFactorization&) {}
+        RelaxFactorization(RelaxFactorization&&) = default;
+        RelaxFactorization& operator=(const RelaxFactorization&)
+        {
+            ldlt.reset();
+            return *this;
+        }
+        RelaxFactorization& operator=(RelaxFactorization&&) = default;
+
+        std::unique_ptr<Eigen::SimplicialLDLT<spMat, Eigen::Lower>> ldlt;
+    };
+    RelaxFactorization relax_ldlt;
+
+    bool relax_iterative(const spMat& K_g, const Eigen::VectorXd& rhs);
+    void relax_direct(const spMat& K_g, const Eigen::VectorXd& rhs);
+
 public:
+    enum class Solver
+    {
+        Direct,     // sparse LDLT factorization
+        Iterative   // LeastSquaresConjugateGradient (lscm), BiCGSTAB (relax),
+                    // falls back to Direct if it fails
+    };
+
     LscmRelax() = default;
     LscmRelax(
         RowMat<double, 3> vertices,
@@ -106,6 +137,9 @@ public:
     double nue=0.9;
     double elasticity=1.;
 
+    Solver lscm_solver=Solver::Direct;
+    Solver relax_solver=Solver::Direct;
+
     void lscm();
     void relax(double);
     void area_relax(double);
@@ -105,6 +105,10 @@ PYBIND11_MODULE(flatmesh, m)
 {
     m.doc() = "functions to unwrapp faces/ meshes";
 
+    py::enum_<lscmrelax::LscmRelax::Solver>(m, "LscmRelaxSolver")
+        .value("Direct", lscmrelax::LscmRelax::Solver::Direct)
+        .value("Iterative", lscmrelax::LscmRelax::Solver::Iterative);
+
     py::class_<lscmrelax::LscmRelax>(m, "LscmRelax")
         .def(py::init<ColMat<double, 3>, ColMat<long, 3>, std::vector<long>>())
         .def("lscm", &lscmrelax::LscmRelax::lscm)
@@ -113,6 +117,8 @@ PYBIND11_MODULE(flatmesh, m)
         .def("transform", &lscmrelax::LscmRelax::transform)
         .def_readonly("rhs", &lscmrelax::LscmRelax::rhs)
         .def_readonly("MATRIX", &lscmrelax::LscmRelax::MATRIX)
+        .def_readwrite("lscm_solver", &lscmrelax::LscmRelax::lscm_solver)
+        .def_readwrite("relax_solver", &lscmrelax::LscmRelax::relax_solver)
         .def_property_readonly("area", &lscmrelax::LscmRelax::get_area)
         .def_property_readonly("flat_area", &lscmrelax::LscmRelax::get_flat_area)
         .def_property_readonly("flat_vertices", [](lscmrelax::LscmRelax& L){return L.flat_vertices.transpose();}, py::return_value_policy::copy)
@@ -0,0 +1,85 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+# ***************************************************************************
+# *                                                                         *
+# *   This file is part of FreeCAD.                                         *
+# *                                                                         *
+# *   FreeCAD is free software: you can redistribute it and/or modify it    *
+# *   under the terms of the GNU Lesser General Public License as           *
+# *   published by the Free Software Foundation, either version 2.1 of the  *
+# *   License, or (at your option) any later version.                       *
+# *                                                                         *
+# *   FreeCAD is distributed in the hope that it will be useful, but        *
+# *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+# *   Lesser General Public License for more details.                       *
+# *                                                                         *
+# *   You should have received a copy of the GNU Lesser General Public      *
+# *   License along with FreeCAD. If not, see                               *
+# *   <https://www.gnu.org/licenses/>.                                      *
+# *                                                                         *
+# ***************************************************************************
+
+import unittest
+import FreeCAD
+import Mesh
+import MeshPart
+
+
+class NearestPointsCases(unittest.TestCase):
+    def setUp(self):
+        # A thin tetrahedron with acute edges. Outside points near its edges
+        # and vertices are often behind the plane of the closest facet.
+        self.corners = [
+            FreeCAD.Vector(0.0, 0.0, 0.0),
+            FreeCAD.Vector(1.0, 0.0, 0.0),
+            FreeCAD.Vector(0.0, 1.0, 0.0),
+            FreeCAD.Vector(0.1, 0.1, 2.0),
+        ]
+        indices = [(0, 2, 1), (0, 1, 3), (1, 2, 3), (0, 3, 2)]
+        self.facets = [[self.corners[i] for i in index] for index in indices]
+        self.mesh = Mesh.Mesh(self.facets)
+
+    def isInside(self, pnt):
+        for p1, p2, p3 in self.facets:
+            normal = (p2 - p1).cross(p3 - p1)
+            if (pnt - p1).dot(normal) >= 0.0:
+                return False
+        return True
+
+    def testClosestPoint(self):
+        points = [FreeCAD.Vector(0.1, 0.1, 2.5), FreeCAD.Vector(0.3, 0.3, -0.5)]
+        result = MeshPart.nearestPoints(points, self.mesh)
+        self.assertEqual(len(result), 2)
+
+        dist, facet, weights, closest = result[0]
+        self.assertAlmostEqual(dist, 0.5, places=5)
+        self.assertTrue(closest.isEqual(self.corners[3], 1e-5))
+
+        dist, facet, weights, closest = result[1]
+        self.assertAlmostEqual(dist, 0.5, places=5)
+        self.assertTrue(closest.isEqual(FreeCAD.Vector(0.3, 0.3, 0.0), 1e-5))
+        self.assertAlmostEqual(sum(weights), 1.0, places=5)
+
+        for pnt, item in zip(points, result):
+            self.assertAlmostEqual(pnt.distanceToPoint(item[3]), item[0], places=5)
+
+    def testSignedAtEdgesAndVertices(self):
+        points = []
+        for i in range(16):
+            for j in range(16):
+                for k in range(16):
+                    points.append(FreeCAD.Vector(-0.5 + i * 0.13, -0.5 + j * 0.13, -0.5 + k * 0.2))
+
+        result = MeshPart.nearestPoints(points, self.mesh, Signed=True)
+        for pnt, item in zip(points, result):
+            dist = item[0]
+            if abs(dist) < 1e-3:
+                continue
+            self.assertEqual(dist < 0.0, self.isInside(pnt), "Wrong sign at {}".format(pnt))
+            self.assertAlmostEqual(pnt.distanceToPoint(item[3]), abs(dist), places=4)
+
+    def testMaxDistance(self):
+        points = [FreeCAD.Vector(0.2, 0.2, 0.1), FreeCAD.Vector(10.0, 10.0, 10.0)]
+        result = MeshPart.nearestPoints(points, self.mesh, 1.0)
+        self.assertIsNotNone(result[0])
+        self.assertIsNone(result[1])
@@ -23,14 +23,28 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+
+#include <QtConcurrentMap>
 
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Failure.hxx>
 #include <Standard_Version.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 #endif
 
 #include <Base/Console.h>
+#include <Base/TimeInfo.h>
 #include <Base/Tools.h>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Part/App/BRepMesh.h>
@@ -235,6 +249,112 @@ Mesh::MeshObject* Mesher::createStandard() const
     return brepmesh.create(domains);
 }
 
+std::vector<Mesh::MeshObject*> Mesher::createMeshes(const std::vector<TopoDS_Shape>& shapes,
+                                                    double deflection,
+                                                    double angularDeflection,
+                                                    bool relative,
+                                                    bool segments,
+                                                    std::vector<FaceTiming>& timings)
+{
+    struct FaceTask
+    {
+        TopoDS_Face face;
+        FaceTiming timing;
+    };
+
+    // Remove old triangulations of all shapes before meshing any face and collect every face
+    // only once, also if it's used by several shapes
+    std::vector<FaceTask> tasks;
+    std::set<const TopoDS_TShape*> collected;
+    for (std::size_t index = 0; index < shapes.size(); index++) {
+        if (shapes[index].IsNull()) {
+            continue;
+        }
+
+        BRepTools::Clean(shapes[index]);
+        TopTools_IndexedMapOfShape faces;
+        TopExp::MapShapes(shapes[index], TopAbs_FACE, faces);
+        for (int i = 1; i <= faces.Extent(); i++) {
+            const TopoDS_Face& face = TopoDS::Face(faces(i));
+            if (collected.insert(face.TShape().get()).second) {
+                FaceTask task;
+                task.face = face;
+                task.timing.shape = index;
+                task.timing.face = static_cast<std::size_t>(i);
+                tasks.push_back(task);
+            }
+        }
+    }
+
+    // Faces that share an edge must not be meshed at the same time. So, every face is put into
+    // the first wave that doesn't contain any of its neighbours. The faces of a wave are meshed
+    // concurrently and reuse the discretization of the edges meshed by the previous waves.
+    std::vector<std::vector<std::size_t>> waves;
+    std::map<const TopoDS_TShape*, std::set<std::size_t>> wavesOfEdge;
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+        std::set<std::size_t> used;
+        for (TopExp_Explorer xp(tasks[i].face, TopAbs_EDGE); xp.More(); xp.Next()) {
+            const std::set<std::size_t>& it = wavesOfEdge[xp.Current().TShape().get()];
+            used.insert(it.begin(), it.end());
+        }
+
+        std::size_t wave = 0;
+        while (used.find(wave) != used.end()) {
+            wave++;
+        }
+        for (TopExp_Explorer xp(tasks[i].face, TopAbs_EDGE); xp.More(); xp.Next()) {
+            wavesOfEdge[xp.Current().TShape().get()].insert(wave);
+        }
+
+        if (wave == waves.size()) {
+            waves.emplace_back();
+        }
+        waves[wave].push_back(i);
+    }
+
+    auto meshFace = [&](std::size_t index) {
+        FaceTask& task = tasks[index];
+        Base::TimeElapsed start;
+        try {
+            BRepMesh_IncrementalMesh aMesh(task.face, deflection, relative, angularDeflection);
+        }
+        catch (const Standard_Failure&) {
+            // a face that cannot be meshed results in an empty domain
+        }
+        task.timing.seconds = Base::TimeElapsed::diffTimeF(start);
+
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(task.face, loc);
+        if (!mesh.IsNull()) {
+            task.timing.facets = static_cast<std::size_t>(mesh->NbTriangles());
+        }
+    };
+
+    for (auto& wave : waves) {
+        QtConcurrent::blockingMap(wave, meshFace);
+    }
+
+    // The triangulations are only read from now on
+    std::vector<std::size_t> indices(shapes.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::vector<Mesh::MeshObject*> meshes(shapes.size(), nullptr);
+    QtConcurrent::blockingMap(indices, [&shapes, &meshes, segments](std::size_t index) {
+        std::vector<Part::TopoShape::Domain> domains;
+        Part::TopoShape(shapes[index]).getDomains(domains);
+        BrepMesh brepmesh(segments, {});
+        meshes[index] = brepmesh.create(domains);
+    });
+
+    // The faces are collected in the order of the shapes and their faces
+    timings.clear();
+    timings.reserve(tasks.size());
+    for (const auto& it : tasks) {
+        timings.push_back(it.timing);
+    }
+
+    return meshes;
+}
+
 Mesh::MeshObject* Mesher::createMesh() const
 {
     // OCC standard mesher
@@ -24,6 +24,7 @@
 #define MESHPART_MESHER_H
 
 #include <sstream>
+#include <vector>
 
 #include <Base/Stream.h>
 
@@ -213,6 +214,30 @@ public:
 
     Mesh::MeshObject* createMesh() const;
 
+    /** @name Batch meshing */
+    //@{
+    struct FaceTiming
+    {
+        std::size_t shape {0};   ///< index of the shape in the input list
+        std::size_t face {0};    ///< index of the face in the shape, starting with 1
+        std::size_t facets {0};  ///< number of triangles of the face
+        double seconds {0};      ///< time needed to mesh the face
+    };
+
+    /** Meshes the given shapes with the standard mesher and returns one mesh per shape.
+     * The faces are meshed concurrently, except for faces with a common edge. These are meshed
+     * one after another so that they reuse the discretization of the common edge and the seams
+     * stay watertight. A face that occurs several times, e.g. in linked copies, is only meshed
+     * once. The caller takes ownership of the returned meshes.
+     */
+    static std::vector<Mesh::MeshObject*> createMeshes(const std::vector<TopoDS_Shape>& shapes,
+                                                       double deflection,
+                                                       double angularDeflection,
+                                                       bool relative,
+                                                       bool segments,
+                                                       std::vector<FaceTiming>& timings);
+    //@}
+
 private:
     Mesh::MeshObject* createStandard() const;
     Mesh::MeshObject* createFrom(SMESH_Mesh*) const;
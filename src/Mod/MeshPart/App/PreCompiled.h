@@ -35,6 +35,7 @@
 #ifdef _PreComp_
 
 // standard
+#include <cfloat>
 #include <cmath>
 #include <iostream>
 
@@ -43,6 +44,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -70,7 +72,9 @@
 #include <Standard_Failure.hxx>
 #include <Standard_Version.hxx>
 #include <TColStd_Array1OfReal.hxx>
+#include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopLoc_Location.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
@@ -78,5 +82,8 @@
 #include <TopoDS_Shape.hxx>
 #include <gp_Pln.hxx>
 
+// Qt
+#include <QtConcurrentMap>
+
 #endif  // _PreComp_
 #endif
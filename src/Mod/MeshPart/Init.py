@@ -23,3 +23,7 @@
 # *   USA                                                                   *
 # *                                                                         *
 # ***************************************************************************/
+
+import FreeCAD
+
+FreeCAD.__unit_test__ += ["MeshPartTestsApp"]
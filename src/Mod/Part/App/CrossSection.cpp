@@ -23,7 +23,12 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <algorithm>
+# include <cmath>
+# include <limits>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
 # include <BRepAdaptor_Surface.hxx>
+# include <BRepBndLib.hxx>
 # include <Mod/Part/App/FCBRepAlgoAPI_Common.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Section.h>
@@ -31,6 +36,7 @@
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
 # include <gp_Pln.hxx>
+# include <OSD_Parallel.hxx>
 # include <Precision.hxx>
 # include <ShapeAnalysis_FreeBounds.hxx>
 # include <ShapeFix_Wire.hxx>
@@ -39,6 +45,7 @@
 # include <TopTools_HSequenceOfShape.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopoDS.hxx>
+# include <TopoDS_Compound.hxx>
 # include <TopoDS_Edge.hxx>
 # include <TopoDS_Wire.hxx>
 #endif
@@ -49,6 +56,42 @@
 
 using namespace Part;
 
+namespace {
+// Range of a*x + b*y + c*z over the bounding box of a shape, i.e. the plane
+// distances for which a slice can hit the shape
+struct SliceRange
+{
+    double min = -std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::max();
+
+    bool contains(double d) const
+    {
+        return d >= min && d <= max;
+    }
+};
+
+SliceRange getSliceRange(const TopoDS_Shape& shape, double a, double b, double c)
+{
+    SliceRange range;
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box);
+    if (box.IsVoid()) {
+        // nothing known about the shape, so never skip it
+        return range;
+    }
+    box.Enlarge(Precision::Confusion());
+    double xMin {}, yMin {}, zMin {}, xMax {}, yMax {}, zMax {};
+    box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    range.min = std::min(a * xMin, a * xMax) + std::min(b * yMin, b * yMax) + std::min(c * zMin, c * zMax);
+    range.max = std::max(a * xMin, a * xMax) + std::max(b * yMin, b * yMax) + std::max(c * zMin, c * zMax);
+    // the plane normal is not necessarily normalized
+    double tol = Precision::Confusion() * std::sqrt(a * a + b * b + c * c);
+    range.min -= tol;
+    range.max += tol;
+    return range;
+}
+}
+
 CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
   : a(a), b(b), c(c), s(s)
 {
@@ -73,6 +116,74 @@ std::list<TopoDS_Wire> CrossSection::slice(double d) const
     return removeDuplicates(wires);
 }
 
+std::vector<std::list<TopoDS_Wire>> CrossSection::slices(const std::vector<double>& d) const
+{
+    // The same sub-shapes as in slice(). Non-solid shells are sliced face by
+    // face, so that only the faces a plane can hit are passed to the section.
+    struct FaceGroup
+    {
+        TopoDS_Shape shape;
+        std::vector<std::pair<TopoDS_Shape, SliceRange>> faces;
+    };
+    std::vector<std::pair<TopoDS_Shape, SliceRange>> solids;
+    std::vector<FaceGroup> groups;
+
+    TopExp_Explorer xp;
+    for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next()) {
+        solids.emplace_back(xp.Current(), getSliceRange(xp.Current(), a, b, c));
+    }
+    for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
+        FaceGroup group;
+        group.shape = xp.Current();
+        for (TopExp_Explorer xpFace(xp.Current(), TopAbs_FACE); xpFace.More(); xpFace.Next()) {
+            group.faces.emplace_back(xpFace.Current(), getSliceRange(xpFace.Current(), a, b, c));
+        }
+        groups.push_back(group);
+    }
+    for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
+        FaceGroup group;
+        group.shape = xp.Current();
+        group.faces.emplace_back(xp.Current(), getSliceRange(xp.Current(), a, b, c));
+        groups.push_back(group);
+    }
+
+    std::vector<std::list<TopoDS_Wire>> result(d.size());
+    OSD_Parallel::For(0, static_cast<int>(d.size()), [&](int index) {
+        double distance = d[index];
+        std::list<TopoDS_Wire> wires;
+        for (const auto& solid : solids) {
+            if (solid.second.contains(distance)) {
+                sliceSolid(distance, solid.first, wires);
+            }
+        }
+        for (const auto& group : groups) {
+            std::vector<TopoDS_Shape> faces;
+            for (const auto& face : group.faces) {
+                if (face.second.contains(distance)) {
+                    faces.push_back(face.first);
+                }
+            }
+            if (faces.empty()) {
+                continue;
+            }
+            if (faces.size() == group.faces.size()) {
+                sliceNonSolid(distance, group.shape, wires);
+                continue;
+            }
+            BRep_Builder builder;
+            TopoDS_Compound comp;
+            builder.MakeCompound(comp);
+            for (const auto& face : faces) {
+                builder.Add(comp, face);
+            }
+            sliceNonSolid(distance, comp, wires);
+        }
+        result[index] = removeDuplicates(wires);
+    });
+
+    return result;
+}
+
 std::list<TopoDS_Wire> CrossSection::removeDuplicates(const std::list<TopoDS_Wire>& wires) const
 {
     std::list<TopoDS_Wire> wires_reduce;
@@ -109,7 +220,11 @@ std::list<TopoDS_Wire> CrossSection::removeDuplicates(const std::list<TopoDS_Wir
 
 void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
 {
-    FCBRepAlgoAPI_Section cs(shape, gp_Pln(a,b,c,-d));
+    // slices() runs this for several planes at once on the same sub-shapes,
+    // so the section must not modify the tolerances of the input shape
+    FCBRepAlgoAPI_Section cs(shape, gp_Pln(a,b,c,-d), Standard_False);
+    cs.SetNonDestructive(Standard_True);
+    cs.Build();
     if (cs.IsDone()) {
         std::list<TopoDS_Edge> edges;
         TopExp_Explorer xp;
@@ -225,23 +340,59 @@ TopoCrossSection::TopoCrossSection(double a, double b, double c, const TopoShape
 {
 }
 
-void TopoCrossSection::slice(int idx, double d, std::vector<TopoShape>& wires) const
+std::vector<TopoShape> TopoCrossSection::sliceShapes(bool& solid) const
 {
     // Fixes: 0001228: Cross section of Torus in Part Workbench fails or give wrong results
     // Fixes: 0001137: Incomplete slices when using Part.slice on a torus
-    bool found = false;
-    for (auto& s : shape.getSubTopoShapes(TopAbs_SOLID)) {
-        sliceSolid(idx, d, s, wires);
-        found = true;
+    auto shapes = shape.getSubTopoShapes(TopAbs_SOLID);
+    solid = !shapes.empty();
+    if (shapes.empty()) {
+        shapes = shape.getSubTopoShapes(TopAbs_SHELL);
+        if (shapes.empty()) {
+            shapes = shape.getSubTopoShapes(TopAbs_FACE);
+        }
     }
-    if (!found) {
-        for (auto& s : shape.getSubTopoShapes(TopAbs_SHELL)) {
+    return shapes;
+}
+
+void TopoCrossSection::slice(int idx, double d, std::vector<TopoShape>& wires) const
+{
+    bool solid = false;
+    for (auto& s : sliceShapes(solid)) {
+        if (solid) {
+            sliceSolid(idx, d, s, wires);
+        }
+        else {
             sliceNonSolid(idx, d, s, wires);
-            found = true;
         }
-        if (!found) {
-            for (auto& s : shape.getSubTopoShapes(TopAbs_FACE)) {
-                sliceNonSolid(idx, d, s, wires);
+    }
+}
+
+void TopoCrossSection::slices(const std::vector<double>& d, std::vector<TopoShape>& wires) const
+{
+    // The slices share the string hasher of the shape for topo naming, so they
+    // are made one after the other. Bounding the sub-shapes along the slicing
+    // direction once still avoids the boolean operations of planes that miss them.
+    bool solid = false;
+    auto shapes = sliceShapes(solid);
+    std::vector<SliceRange> ranges;
+    ranges.reserve(shapes.size());
+    for (auto& s : shapes) {
+        ranges.push_back(getSliceRange(s.getShape(), a, b, c));
+    }
+
+    int idx = 0;
+    for (double distance : d) {
+        ++idx;
+        for (std::size_t i = 0; i < shapes.size(); ++i) {
+            if (!ranges[i].contains(distance)) {
+                continue;
+            }
+            if (solid) {
+                sliceSolid(idx, distance, shapes[i], wires);
+            }
+            else {
+                sliceNonSolid(idx, distance, shapes[i], wires);
             }
         }
     }
@@ -24,6 +24,7 @@
 #define PART_CROSSSECTION_H
 
 #include <list>
+#include <vector>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <Mod/Part/PartGlobal.h>
 #include "TopoShape.h"
@@ -39,6 +40,16 @@ class PartExport CrossSection
 public:
     CrossSection(double a, double b, double c, const TopoDS_Shape& s);
     std::list<TopoDS_Wire> slice(double d) const;
+    /** Slice the shape with many parallel planes
+     *
+     * The sub-shapes are bounded along the slicing direction once, so that
+     * each plane is only intersected with the solids and faces it can hit,
+     * and the planes are computed concurrently.
+     *
+     * @param d: the plane distances
+     * @return the wires of each slice, in the order of d
+     */
+    std::vector<std::list<TopoDS_Wire>> slices(const std::vector<double>& d) const;
 
 private:
     void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
@@ -59,10 +70,14 @@ public:
     TopoCrossSection(double a, double b, double c, const TopoShape& s, const char* op = 0);
     void slice(int idx, double d, std::vector<TopoShape>& wires) const;
     TopoShape slice(int idx, double d) const;
+    /// Slice with many parallel planes, skipping the sub-shapes a plane cannot hit.
+    /// The slice of d[i] uses index i + 1 for topo naming.
+    void slices(const std::vector<double>& d, std::vector<TopoShape>& wires) const;
 
 private:
     void sliceNonSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
     void sliceSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
+    std::vector<TopoShape> sliceShapes(bool& solid) const;
 
 private:
     double a, b, c;
@@ -23,7 +23,10 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <array>
+# include <cstdint>
 # include <sstream>
+# include <boost/crc.hpp>
 # include <Bnd_Box.hxx>
 # include <BRepBndLib.hxx>
 # include <BRepBuilderAPI_Copy.hxx>
@@ -562,6 +565,162 @@ void PropertyPartShape::loadFromStream(Base::Reader &reader)
     }
 }
 
+namespace {
+// Binary shape files end with this tag followed by the CRC-32 of the shape
+// data. Readers not knowing about it simply ignore the trailing bytes.
+constexpr std::array<char, 8> BinaryChecksumTag {'F', 'C', 'B', 'R', 'C', 'R', 'C', '1'};
+
+// Forwards the written bytes to another stream buffer and computes their checksum
+class ChecksumOutBuf : public std::streambuf
+{
+public:
+    explicit ChecksumOutBuf(std::streambuf* buf)
+        : buf(buf)
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+    ~ChecksumOutBuf() override
+    {
+        flushBuffer();
+    }
+    std::uint32_t checksum()
+    {
+        flushBuffer();
+        return crc.checksum();
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!flushBuffer()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+    int sync() override
+    {
+        return flushBuffer() ? buf->pubsync() : -1;
+    }
+
+private:
+    bool flushBuffer()
+    {
+        std::streamsize count = pptr() - pbase();
+        if (count == 0) {
+            return true;
+        }
+        crc.process_bytes(pbase(), static_cast<std::size_t>(count));
+        bool ok = buf->sputn(pbase(), count) == count;
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return ok;
+    }
+
+    std::streambuf* buf;
+    boost::crc_32_type crc;
+    std::array<char, 65536> buffer {};
+};
+
+// Reads from another stream buffer and computes the checksum of the consumed bytes
+class ChecksumInBuf : public std::streambuf
+{
+public:
+    explicit ChecksumInBuf(std::streambuf* buf)
+        : buf(buf)
+    {
+        setg(buffer.data(), buffer.data(), buffer.data());
+        checked = buffer.data();
+    }
+    /// Checksum of all bytes consumed so far
+    std::uint32_t checksum()
+    {
+        crc.process_block(checked, gptr());
+        checked = gptr();
+        return crc.checksum();
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        crc.process_block(checked, egptr());
+        consumed += egptr() - eback();
+        std::streamsize count = buf->sgetn(buffer.data(), buffer.size());
+        setg(buffer.data(), buffer.data(), buffer.data() + count);
+        checked = buffer.data();
+        if (count <= 0) {
+            return traits_type::eof();
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        // only support querying the current position
+        if (off != 0 || dir != std::ios_base::cur || !(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        return pos_type(consumed + (gptr() - eback()));
+    }
+
+private:
+    std::streambuf* buf;
+    boost::crc_32_type crc;
+    const char* checked;
+    off_type consumed = 0;
+    std::array<char, 65536> buffer {};
+};
+}
+
+void PropertyPartShape::saveToBinary(Base::Writer &writer) const
+{
+    bool withTriangles = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("BinaryTriangulation", false);
+
+    ChecksumOutBuf buf(writer.Stream().rdbuf());
+    std::ostream out(&buf);
+    _Shape.exportBinary(out, withTriangles);
+    out.flush();
+    std::uint32_t checksum = buf.checksum();
+
+    std::array<char, 4> bytes {};
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>((checksum >> (8 * i)) & 0xff);
+    }
+    writer.Stream().write(BinaryChecksumTag.data(), BinaryChecksumTag.size());
+    writer.Stream().write(bytes.data(), bytes.size());
+}
+
+bool PropertyPartShape::loadFromBinary(Base::Reader &reader)
+{
+    // Read the shape straight from the zip entry while computing the checksum
+    ChecksumInBuf buf(reader.rdbuf());
+    std::istream in(&buf);
+    TopoShape shape;
+    shape.importBinary(in);
+    std::uint32_t checksum = buf.checksum();
+
+    // Files written by older versions have no checksum
+    bool valid = true;
+    std::array<char, 8> tag {};
+    std::array<char, 4> bytes {};
+    if (in.read(tag.data(), tag.size()) && tag == BinaryChecksumTag
+        && in.read(bytes.data(), bytes.size())) {
+        std::uint32_t expected = 0;
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            expected |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+        }
+        valid = (expected == checksum);
+    }
+
+    setValue(shape);
+    return valid;
+}
+
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
     // If the shape is empty we simply store nothing. The file size will be 0 which
@@ -570,9 +729,7 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
         return;
     TopoDS_Shape myShape = _Shape.getShape();
     if (writer.getMode("BinaryBrep")) {
-        TopoShape shape;
-        shape.setShape(myShape);
-        shape.exportBinary(writer.Stream());
+        saveToBinary(writer);
     }
     else {
         bool direct = App::GetApplication().GetParameterGroupByPath
@@ -607,8 +764,9 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 
     std::string ver = _Ver;
 
+    bool valid = true;
     if (brep.hasExtension("bin")) {
-        shape.importBinary(reader);
+        valid = loadFromBinary(reader);
     }
     else {
         bool direct = App::GetApplication().GetParameterGroupByPath
@@ -621,14 +779,25 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
             loadFromStream(reader);
             reader.exceptions(iostate);
         }
-        shape = getValue();
     }
+    shape = getValue();
 
     // restore the element map
     shape.Hasher = hasher;
     shape.resetElementMap(elementMap);
     setValue(shape);
     _Ver = ver;
+
+    // The shape is kept as far as it could be read but the caller is told about the corruption
+    if (!valid) {
+        std::stringstream str;
+        str << "Checksum mismatch in binary shape file '" << reader.getFileName() << "'";
+        App::PropertyContainer* father = this->getContainer();
+        if (father && father->isDerivedFrom<App::DocumentObject>()) {
+            str << " of '" << static_cast<App::DocumentObject*>(father)->Label.getValue() << "'";
+        }
+        throw Base::RestoreError(str.str());
+    }
 }
 
 // -------------------------------------------------------------------------
@@ -108,8 +108,10 @@ public:
 
 private:
     void saveToFile(Base::Writer &writer) const;
+    void saveToBinary(Base::Writer &writer) const;
     void loadFromFile(Base::Reader &reader);
     void loadFromStream(Base::Reader &reader);
+    bool loadFromBinary(Base::Reader &reader);
 
 private:
     TopoShape _Shape;
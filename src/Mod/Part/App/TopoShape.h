@@ -44,9 +44,11 @@
 #include <BRepTools_ReShape.hxx>
 #include <ShapeFix_Root.hxx>
 
+class Bnd_Box;
 class gp_Ax1;
 class gp_Ax2;
 class gp_Pln;
+class gp_Pnt;
 class gp_Vec;
 
 namespace App
@@ -477,7 +479,7 @@ public:
     void exportStep(const char* FileName) const;
     void exportBrep(const char* FileName) const;
     void exportBrep(std::ostream&) const;
-    void exportBinary(std::ostream&) const;
+    void exportBinary(std::ostream&, bool withTriangles = false) const;
     void exportStl(const char* FileName, double deflection) const;
     void exportFaceSet(double, double, const std::vector<App::Color>&, std::ostream&) const;
     void exportLineSet(std::ostream&) const;
@@ -1469,6 +1471,28 @@ public:
     std::vector<int> findAncestors(const TopoDS_Shape& subshape, TopAbs_ShapeEnum type) const;
     std::vector<TopoDS_Shape> findAncestorsShapes(const TopoDS_Shape& subshape,
                                                   TopAbs_ShapeEnum type) const;
+    /** Find sub shapes whose bounding box intersects the given box
+     *
+     * @param type: the sub shape type
+     * @param box: the query box in the coordinate system of this shape
+     *
+     * @return Sorted 1-based indices of the found sub shapes. The bounding
+     * boxes are indexed in an R-tree built on first use and kept in the cache.
+     */
+    std::vector<int> findSubShapesInBox(TopAbs_ShapeEnum type, const Bnd_Box& box) const;
+    /** Find sub shapes closest to a given point
+     *
+     * @param type: the sub shape type
+     * @param pnt: the query point in the coordinate system of this shape
+     * @param count: maximum number of sub shapes to return
+     *
+     * @return 1-based indices of the found sub shapes, ordered by increasing
+     * distance between the point and the sub shape bounding box. Use it as a
+     * candidate list if the exact geometric distance matters.
+     */
+    std::vector<int> findNearestSubShapes(TopAbs_ShapeEnum type,
+                                          const gp_Pnt& pnt,
+                                          int count = 1) const;
     /** Find sub shapes with shared Vertexes.
      *
      * Renamed: searchSubShape -> findSubShapesWithSharedVertex
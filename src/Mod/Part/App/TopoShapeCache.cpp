@@ -23,10 +23,40 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <BRepBndLib.hxx>
+#endif
+
+#include <boost/geometry.hpp>
+
 #include "TopoShapeCache.h"
 
 using namespace Part;
 
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+using BoxPoint = bg::model::point<double, 3, bg::cs::cartesian>;
+using BoxType = bg::model::box<BoxPoint>;
+using BoxValue = std::pair<BoxType, int>;
+
+BoxType toBox(const Bnd_Box& bound)
+{
+    double xMin {}, yMin {}, zMin {}, xMax {}, yMax {}, zMax {};
+    bound.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    return {BoxPoint(xMin, yMin, zMin), BoxPoint(xMax, yMax, zMax)};
+}
+}  // namespace
+
+struct TopoShapeCache::BoxIndex
+{
+    bgi::rtree<BoxValue, bgi::linear<16>> tree;
+};
+
 ShapeRelationKey::ShapeRelationKey(Data::MappedName name, HistoryTraceType historyTraceType)
     : name(std::move(name))
     , historyTraceType(historyTraceType)
@@ -253,3 +283,69 @@ TopoDS_Shape TopoShapeCache::findAncestor(const TopoDS_Shape& parent,
     }
     return TopoShape::moved(shapes.First(), parent.Location());
 }
+
+const TopoShapeCache::BoxIndex& TopoShapeCache::getBoxIndex(TopAbs_ShapeEnum type)
+{
+    auto& ancestry = getAncestry(type);
+    if (!ancestry.boxIndex) {
+        std::vector<BoxValue> values;
+        values.reserve(ancestry.shapes.Extent());
+        for (int i = 1; i <= ancestry.shapes.Extent(); ++i) {
+            Bnd_Box bound;
+            BRepBndLib::Add(ancestry.shapes.FindKey(i), bound);
+            if (!bound.IsVoid()) {
+                values.emplace_back(toBox(bound), i);
+            }
+        }
+        ancestry.boxIndex = std::make_shared<BoxIndex>();
+        // Use the packing constructor, which gives a better balanced tree than inserting one by
+        // one.
+        ancestry.boxIndex->tree = decltype(BoxIndex::tree)(values.begin(), values.end());
+    }
+    return *ancestry.boxIndex;
+}
+
+std::vector<int>
+TopoShapeCache::findShapesInBox(const TopoDS_Shape& parent, TopAbs_ShapeEnum type, const Bnd_Box& box)
+{
+    std::vector<int> res;
+    if (shape.IsNull() || box.IsVoid()) {
+        return res;
+    }
+    Bnd_Box localBox = box;
+    if (!parent.Location().IsIdentity()) {
+        localBox = box.Transformed(parent.Location().Inverted().Transformation());
+    }
+    const auto& index = getBoxIndex(type);
+    for (auto it = index.tree.qbegin(bgi::intersects(toBox(localBox))); it != index.tree.qend();
+         ++it) {
+        res.push_back(it->second);
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+std::vector<int> TopoShapeCache::findNearestShapes(const TopoDS_Shape& parent,
+                                                   TopAbs_ShapeEnum type,
+                                                   const gp_Pnt& pnt,
+                                                   int count)
+{
+    std::vector<int> res;
+    if (shape.IsNull() || count <= 0) {
+        return res;
+    }
+    gp_Pnt localPnt = pnt;
+    if (!parent.Location().IsIdentity()) {
+        localPnt.Transform(parent.Location().Inverted().Transformation());
+    }
+    const auto& index = getBoxIndex(type);
+    // Incremental nearest queries are returned in order of increasing distance
+    for (auto it = index.tree.qbegin(
+             bgi::nearest(BoxPoint(localPnt.X(), localPnt.Y(), localPnt.Z()),
+                          static_cast<unsigned>(count)));
+         it != index.tree.qend();
+         ++it) {
+        res.push_back(it->second);
+    }
+    return res;
+}
@@ -29,6 +29,8 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <Bnd_Box.hxx>
+#include <gp_Pnt.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Iterator.hxx>
@@ -85,6 +87,9 @@ public:
         TopTools_IndexedDataMapOfShapeListOfShape shapes;
     };
 
+    /// Spatial index of the bounding boxes of sub-shapes, defined in TopoShapeCache.cpp
+    struct BoxIndex;
+
     /// Class for caching the ancestor and children shapes mapping
     class PartExport Ancestry
     {
@@ -104,6 +109,11 @@ public:
         /// faces containing a given edge.
         std::array<AncestorInfo, TopAbs_SHAPE + 1> ancestors;
 
+        /// R-tree of the bounding boxes of the children shapes, built on demand by
+        /// TopoShapeCache::getBoxIndex(). The boxes only depend on geometry, so the index is kept
+        /// when the element map is reset.
+        std::shared_ptr<BoxIndex> boxIndex;
+
         TopoShape _getTopoShape(const TopoShape& parent, int index);
 
     public:
@@ -122,6 +132,7 @@ public:
     void insertRelation(const ShapeRelationKey& key, const QVector<Data::MappedElement>& value);
     bool isTouched(const TopoDS_Shape& tds) const;
     Ancestry& getAncestry(TopAbs_ShapeEnum type);
+    const BoxIndex& getBoxIndex(TopAbs_ShapeEnum type);
     int countShape(TopAbs_ShapeEnum type);
     int findShape(const TopoDS_Shape& parent, const TopoDS_Shape& subShape);
     TopoDS_Shape findShape(const TopoDS_Shape& parent, TopAbs_ShapeEnum type, int index);
@@ -135,6 +146,22 @@ public:
                               TopAbs_ShapeEnum type,
                               std::vector<TopoDS_Shape>* ancestors = nullptr);
 
+    /// Return the indices (1-based, as used by findShape()) of the sub-shapes of the given type
+    /// whose bounding box intersects the given box, in ascending order. The box is expressed in
+    /// the coordinate system of parent. The spatial index is built on first use, so that repeated
+    /// geometric searches on an unchanged shape avoid a linear scan over all sub-shapes.
+    std::vector<int>
+    findShapesInBox(const TopoDS_Shape& parent, TopAbs_ShapeEnum type, const Bnd_Box& box);
+
+    /// Return the indices of at most count sub-shapes of the given type, ordered by increasing
+    /// distance from the given point to their bounding box. Note that the box distance is only a
+    /// lower bound of the actual distance to the sub-shape, so callers needing the exact nearest
+    /// shape should refine the returned candidates.
+    std::vector<int> findNearestShapes(const TopoDS_Shape& parent,
+                                       TopAbs_ShapeEnum type,
+                                       const gp_Pnt& pnt,
+                                       int count = 1);
+
     /// Ancestor and children shape caches of all shape types. Note that
     /// shapeAncestryCache[TopAbs_SHAPE] is also valid and stores the direct children of a
     /// compound shape.
@@ -34,6 +34,7 @@
 #include <BRepAdaptor_HCompCurve.hxx>
 #endif
 
+#include <Bnd_Box.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepCheck_Analyzer.hxx>
 #include <BRepFill.hxx>
@@ -117,6 +118,12 @@ using BRepAdaptor_HCompCurve = BRepAdaptor_CompCurve;
 namespace Part
 {
 
+// Minimum number of sub shapes before geometric sub shape searches switch from
+// a linear scan to the spatial index cached in TopoShapeCache. Small shapes,
+// such as the temporary ones created while searching composite shapes, are
+// not worth building an index for.
+static constexpr unsigned long SpatialSearchThreshold = 64;
+
 static void expandCompound(const TopoShape& shape, std::vector<TopoShape>& res)
 {
     if (shape.isNull()) {
@@ -434,24 +441,40 @@ std::vector<TopoShape> TopoShape::findSubShapesWithSharedVertex(const TopoShape&
                 }
             }
             break;
-        case TopAbs_VERTEX:
+        case TopAbs_VERTEX: {
             // Vertex search will do comparison with tolerance to account for
             // rounding error inccured through transformation.
-            for (auto& shape : getSubTopoShapes(TopAbs_VERTEX)) {
-                ++index;
-                if (BRep_Tool::Pnt(TopoDS::Vertex(shape.getShape()))
-                        .SquareDistance(BRep_Tool::Pnt(TopoDS::Vertex(subshape.getShape())))
-                    <= tol2) {
-                    if (names) {
-                        names->push_back(std::string("Vertex") + std::to_string(index));
-                    }
-                    res.push_back(shape);
-                    if (singleSearch) {
+            gp_Pnt pnt = BRep_Tool::Pnt(TopoDS::Vertex(subshape.getShape()));
+            auto checkVertex = [&](const TopoShape& shape, int idx) {
+                if (BRep_Tool::Pnt(TopoDS::Vertex(shape.getShape())).SquareDistance(pnt) > tol2) {
+                    return false;
+                }
+                if (names) {
+                    names->push_back(std::string("Vertex") + std::to_string(idx));
+                }
+                res.push_back(shape);
+                return singleSearch;
+            };
+            if (countSubShapes(TopAbs_VERTEX) < SpatialSearchThreshold) {
+                for (auto& shape : getSubTopoShapes(TopAbs_VERTEX)) {
+                    if (checkVertex(shape, ++index)) {
                         return res;
                     }
                 }
+                break;
+            }
+            // Use the cached spatial index of the vertex bounding boxes (which
+            // already include the vertex tolerance) to avoid a linear scan.
+            Bnd_Box box;
+            box.Add(pnt);
+            box.Enlarge(tol);
+            for (int idx : findSubShapesInBox(TopAbs_VERTEX, box)) {
+                if (checkVertex(getSubTopoShape(TopAbs_VERTEX, idx), idx)) {
+                    return res;
+                }
             }
             break;
+        }
         case TopAbs_EDGE:
         case TopAbs_FACE: {
             std::unique_ptr<Geometry> geom;
@@ -701,6 +724,19 @@ std::vector<TopoDS_Shape> TopoShape::findAncestorsShapes(const TopoDS_Shape& sub
     return shapes;
 }
 
+std::vector<int> TopoShape::findSubShapesInBox(TopAbs_ShapeEnum type, const Bnd_Box& box) const
+{
+    initCache();
+    return _cache->findShapesInBox(_Shape, type, box);
+}
+
+std::vector<int>
+TopoShape::findNearestSubShapes(TopAbs_ShapeEnum type, const gp_Pnt& pnt, int count) const
+{
+    initCache();
+    return _cache->findNearestShapes(_Shape, type, pnt, count);
+}
+
 // The following lines should be used for now to replace the original macros (in the future we can
 // refactor to use std::source_location and eliminate the use of the macros entirely).
 //     FC_THROWM(NullShapeException, "Null shape");
@@ -3929,10 +3965,7 @@ TopoShape& TopoShape::makeElementSlices(const TopoShape& shape,
 {
     std::vector<TopoShape> wires;
     TopoCrossSection cs(dir.x, dir.y, dir.z, shape, op);
-    int index = 0;
-    for (auto& distance : distances) {
-        cs.slice(++index, distance, wires);
-    }
+    cs.slices(distances, wires);
     return makeElementCompound(wires, op, SingleShapeCompoundCreationPolicy::returnShape);
 }
 
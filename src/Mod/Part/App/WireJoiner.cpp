@@ -39,7 +39,9 @@
 # include <BRepGProp.hxx>
 # include <BRepTools.hxx>
 # include <BRepTools_WireExplorer.hxx>
+# include <gp_Lin.hxx>
 # include <gp_Pln.hxx>
+# include <ElCLib.hxx>
 # include <GeomAdaptor_Curve.hxx>
 # include <GeomLProp_CLProps.hxx>
 # include <GProp_GProps.hxx>
@@ -54,8 +56,10 @@
 #endif
 
 #include <BRepTools_History.hxx>
+#include <OSD_Parallel.hxx>
 #include <ShapeBuild_ReShape.hxx>
 
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <deque>
@@ -1166,11 +1170,63 @@ public:
         return true;
     }
 
+    // This method was originally part of WireJoinerP::checkIntersection(), split to reduce
+    // cognitive complexity
+    //
+    // Line segments are by far the most common input (e.g. DXF import), and
+    // their intersection can be computed directly, instead of building the
+    // wire and face required by ShapeAnalysis_Wire. Returns false if the
+    // edges are not both lines, or are (nearly) parallel, in which case the
+    // generic check is used.
+    bool checkIntersectionLinear(const EdgeInfo& info,
+                                 const EdgeInfo& other,
+                                 std::set<IntersectInfo>& params1,
+                                 std::set<IntersectInfo>& params2)
+    {
+        if (info.type != GeomAbs_Line || other.type != GeomAbs_Line) {
+            return false;
+        }
+        gp_Lin line1 = GeomAdaptor_Curve(info.curve).Line();
+        gp_Lin line2 = GeomAdaptor_Curve(other.curve).Line();
+        const gp_XYZ& dir1 = line1.Direction().XYZ();
+        const gp_XYZ& dir2 = line2.Direction().XYZ();
+        gp_XYZ offset = line1.Location().XYZ() - line2.Location().XYZ();
+        double cosAngle = dir1.Dot(dir2);
+        double sinAngle2 = 1.0 - cosAngle * cosAngle;
+        const double parallelTol {1e-6};
+        if (sinAngle2 < parallelTol) {
+            return false;
+        }
+
+        // Closest points of the two segments, with line parameters measured
+        // the same way as the edge curve parameters.
+        double c = dir1.Dot(offset);
+        double f = dir2.Dot(offset);
+        double param1 = std::clamp((cosAngle * f - c) / sinAngle2, info.firstParam, info.lastParam);
+        double param2 = std::clamp(f + cosAngle * param1, other.firstParam, other.lastParam);
+        param1 = std::clamp(cosAngle * param2 - c, info.firstParam, info.lastParam);
+
+        gp_Pnt pt1 = ElCLib::Value(param1, line1);
+        gp_Pnt pt2 = ElCLib::Value(param2, line2);
+        if (pt1.SquareDistance(pt2) >= myTol2) {
+            return true;
+        }
+        const double halving {0.5};
+        gp_Pnt pt((pt1.XYZ() + pt2.XYZ()) * halving);
+        pushIntersection(params1, param1, pt, other.edge);
+        pushIntersection(params2, param2, pt, info.edge);
+        return true;
+    }
+
     void checkIntersection(const EdgeInfo &info,
                            const EdgeInfo &other,
                            std::set<IntersectInfo> &params1,
                            std::set<IntersectInfo> &params2)
     {
+        if (checkIntersectionLinear(info, other, params1, params2)) {
+            return;
+        }
+
         if(!checkIntersectionPlanar(info, other, params1, params2)){
             return;
         }
@@ -1322,19 +1378,16 @@ public:
             }
         }
 
-        idx=0;
-        std::vector<SplitInfo> splits;
-        for (auto it=edges.begin(); it!=edges.end(); ) {
-            ++idx;
+        // Collect the edges to be split together with their split parameters
+        std::vector<std::pair<Edges::iterator, std::set<IntersectInfo>*>> toSplit;
+        for (auto it=edges.begin(); it!=edges.end(); ++it) {
             auto iter = intersects.find(&(*it));
             if (iter == intersects.end()) {
-                ++it;
                 continue;
             }
             auto &info = *it;
             auto &params = iter->second;
             if (params.empty()) {
-                ++it;
                 continue;
             }
 
@@ -1350,18 +1403,30 @@ public:
             }
             params.emplace(info.lastParam, info.p2, TopoDS_Shape());
 
-            if (params.size() <= 2) {
-                ++it;
-                continue;
+            if (params.size() > 2) {
+                toSplit.emplace_back(it, &params);
             }
+        }
 
-            splits.clear();
-            itParam = params.begin();
-
-            splitEdgesMakeEdges(itParam, params, info, splits);
+        // The split edges only depend on the curve of their own source edge,
+        // so they can be built concurrently. Showing shapes for debugging
+        // creates document objects and therefore forces a serial run.
+        std::vector<std::vector<SplitInfo>> splitResults(toSplit.size());
+        OSD_Parallel::For(
+            0,
+            static_cast<int>(toSplit.size()),
+            [&](int index) {
+                auto& params = *toSplit[index].second;
+                auto itParam = params.begin();
+                splitEdgesMakeEdges(itParam, params, *toSplit[index].first, splitResults[index]);
+            },
+            canShowShape());
 
+        for (std::size_t index = 0; index < toSplit.size(); ++index) {
+            auto it = toSplit[index].first;
+            auto &info = *it;
+            const auto &splits = splitResults[index];
             if (splits.size() <= 1) {
-                ++it;
                 continue;
             }
 
@@ -24,7 +24,10 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cmath>
 # include <iterator>
+# include <numeric>
+# include <unordered_map>
 # include <Bnd_Box.hxx>
 # include <BRep_Builder.hxx>
 # include <BRep_Tool.hxx>
@@ -63,6 +66,8 @@
 # include <TopExp_Explorer.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfIntegerListOfShape.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfShapeShape.hxx>
+# include <TopTools_DataMapOfShapeInteger.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_ListIteratorOfListOfShape.hxx>
 # include <TopTools_ListOfShape.hxx>
 #endif // _PreComp_
@@ -85,7 +90,12 @@ void ModelRefine::getFaceEdges(const TopoDS_Face &face, EdgeVectorType &edges)
 void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edgesOut)
 {
     //this finds all the boundary edges. Maybe more than one boundary.
-    std::list<TopoDS_Edge> edges;
+    //An edge shared by two faces of the group cancels out. The edges are kept in
+    //the order they were (last) added, and a map from edge to its slot in the
+    //list replaces searching the list for every face edge.
+    EdgeVectorType edges;
+    std::vector<bool> alive;
+    TopTools_DataMapOfShapeInteger slots;
     FaceVectorType::const_iterator faceIt;
     for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
     {
@@ -94,24 +104,27 @@ void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edg
         getFaceEdges(*faceIt, faceEdges);
         for (faceEdgesIt = faceEdges.begin(); faceEdgesIt != faceEdges.end(); ++faceEdgesIt)
         {
-            bool foundSignal(false);
-            std::list<TopoDS_Edge>::iterator edgesIt;
-            for (edgesIt = edges.begin(); edgesIt != edges.end(); ++edgesIt)
+            Standard_Integer *slot = slots.ChangeSeek(*faceEdgesIt);
+            if (slot && alive[*slot])
             {
-                if ((*edgesIt).IsSame(*faceEdgesIt))
-                {
-                    edgesIt = edges.erase(edgesIt);
-                    foundSignal = true;
-                    break;
-                }
+                alive[*slot] = false;
+                continue;
             }
-            if (!foundSignal)
-                edges.push_back(*faceEdgesIt);
+            int index = static_cast<int>(edges.size());
+            edges.push_back(*faceEdgesIt);
+            alive.push_back(true);
+            if (slot)
+                *slot = index;
+            else
+                slots.Bind(*faceEdgesIt, index);
         }
     }
 
-    edgesOut.reserve(edges.size());
-    std::copy(edges.begin(), edges.end(), back_inserter(edgesOut));
+    for (std::size_t index = 0; index < edges.size(); ++index)
+    {
+        if (alive[index])
+            edgesOut.push_back(edges[index]);
+    }
 }
 
 TopoDS_Shell ModelRefine::removeFaces(const TopoDS_Shell &shell, const FaceVectorType &faces)
@@ -255,26 +268,54 @@ void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorTyp
 
 void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *object)
 {
+    //Faces are hashed into buckets of their equality key, so that only the
+    //groups of the same and the neighbouring buckets have to be compared with
+    //isEqual(). Faces without a key are compared with every group. The group
+    //chosen for a face is the first matching one in creation order, like a
+    //plain linear search would find.
     std::vector<FaceVectorType> tempVector;
     tempVector.reserve(faces.size());
+    std::unordered_map<long long, std::vector<std::size_t>> buckets;
+    std::vector<std::size_t> candidates;
     FaceVectorType::const_iterator faceIt;
     for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
     {
+        double key(0.0);
+        bool hasKey = object->getEqualityKey(*faceIt, key);
+        long long bucket(0);
+        candidates.clear();
+        if (hasKey)
+        {
+            bucket = static_cast<long long>(std::floor(key / FaceTypedBase::equalityKeyWidth));
+            for (long long neighbour = bucket - 1; neighbour <= bucket + 1; ++neighbour)
+            {
+                auto bucketIt = buckets.find(neighbour);
+                if (bucketIt != buckets.end())
+                    candidates.insert(candidates.end(), bucketIt->second.begin(), bucketIt->second.end());
+            }
+            std::sort(candidates.begin(), candidates.end());
+        }
+        else
+        {
+            candidates.resize(tempVector.size());
+            std::iota(candidates.begin(), candidates.end(), 0);
+        }
+
         bool foundMatch(false);
-        std::vector<FaceVectorType>::iterator tempIt;
-        for (tempIt = tempVector.begin(); tempIt != tempVector.end(); ++tempIt)
+        for (std::size_t index : candidates)
         {
-            if (object->isEqual((*tempIt).front(), *faceIt))
+            if (object->isEqual(tempVector[index].front(), *faceIt))
             {
-                (*tempIt).push_back(*faceIt);
+                tempVector[index].push_back(*faceIt);
                 foundMatch = true;
                 break;
             }
         }
         if (!foundMatch)
         {
+            if (hasKey)
+                buckets[bucket].push_back(tempVector.size());
             FaceVectorType another;
-            another.reserve(faces.size());
             another.push_back(*faceIt);
             tempVector.push_back(another);
         }
@@ -297,46 +338,76 @@ GeomAbs_SurfaceType FaceTypedBase::getFaceType(const TopoDS_Face &faceIn)
     return surfaceTest.GetType();
 }
 
+bool FaceTypedBase::getEqualityKey(const TopoDS_Face &, double &) const
+{
+    return false;
+}
+
+// Fixed direction to project points on when a scalar key is needed. It is
+// chosen to be skewed to the coordinate axes, so that regular patterns along
+// them rarely end up in the same bucket.
+static const gp_Dir keyDirection(0.8017837257, 0.5345224838, 0.2672612419);
+
 void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<EdgeVectorType> &boundariesOut) const
 {
-    EdgeVectorType bEdges;
-    boundaryEdges(facesIn, bEdges);
+    EdgeVectorType edges;
+    boundaryEdges(facesIn, edges);
+
+    //Index the edges by their first vertex, so that the next edge of a boundary
+    //is looked up instead of searched for. For every vertex the edges are kept
+    //in their original order and the first unused one is taken.
+    TopTools_IndexedMapOfShape vertices;
+    std::vector<int> firstVertices, lastVertices;
+    firstVertices.reserve(edges.size());
+    lastVertices.reserve(edges.size());
+    for (const auto &edge : edges)
+    {
+        firstVertices.push_back(vertices.Add(TopExp::FirstVertex(edge, Standard_True)));
+        lastVertices.push_back(vertices.Add(TopExp::LastVertex(edge, Standard_True)));
+    }
+    std::vector<std::vector<std::size_t>> edgesByVertex(vertices.Extent() + 1);
+    for (std::size_t index = 0; index < edges.size(); ++index)
+        edgesByVertex[firstVertices[index]].push_back(index);
+    std::vector<std::size_t> nextCandidate(edgesByVertex.size(), 0);
+    std::vector<bool> used(edges.size(), false);
+
+    auto takeEdgeFrom = [&](int vertex) -> long {
+        auto &candidates = edgesByVertex[vertex];
+        auto &next = nextCandidate[vertex];
+        while (next < candidates.size() && used[candidates[next]])
+            ++next;
+        if (next == candidates.size())
+            return -1;
+        return static_cast<long>(candidates[next]);
+    };
 
-    std::list<TopoDS_Edge> edges;
-    std::copy(bEdges.begin(), bEdges.end(), back_inserter(edges));
-    while(!edges.empty())
+    for (std::size_t start = 0; start < edges.size(); ++start)
     {
-        TopoDS_Vertex destination = TopExp::FirstVertex(edges.front(), Standard_True);
-        TopoDS_Vertex lastVertex = TopExp::LastVertex(edges.front(), Standard_True);
+        if (used[start])
+            continue;
+        used[start] = true;
+        int destination = firstVertices[start];
+        int lastVertex = lastVertices[start];
         EdgeVectorType boundary;
-        boundary.push_back(edges.front());
-        edges.pop_front();
+        boundary.push_back(edges[start]);
         //single edge closed check.
-        if (destination.IsSame(lastVertex))
+        if (destination == lastVertex)
         {
             boundariesOut.push_back(boundary);
             continue;
         }
 
         bool closedSignal(false);
-        std::list<TopoDS_Edge>::iterator it;
-        for (it = edges.begin(); it != edges.end();)
+        for (long current = takeEdgeFrom(lastVertex); current >= 0; current = takeEdgeFrom(lastVertex))
         {
-            TopoDS_Vertex currentVertex = TopExp::FirstVertex(*it, Standard_True);
-            if (lastVertex.IsSame(currentVertex))
+            used[current] = true;
+            boundary.push_back(edges[current]);
+            lastVertex = lastVertices[current];
+            if (lastVertex == destination)
             {
-                boundary.push_back(*it);
-                lastVertex = TopExp::LastVertex(*it, Standard_True);
-                edges.erase(it);
-                it = edges.begin();
-                if (lastVertex.IsSame(destination))
-                {
-                    closedSignal = true;
-                    break;
-                }
-                continue;
+                closedSignal = true;
+                break;
             }
-            ++it;
         }
         if (closedSignal)
             boundariesOut.push_back(boundary);
@@ -381,6 +452,18 @@ bool FaceTypedPlane::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &face
             planeOne.Distance(planeTwo.Position().Location()) < Precision::Confusion());
 }
 
+bool FaceTypedPlane::getEqualityKey(const TopoDS_Face &face, double &key) const
+{
+    Handle(Geom_Plane) planeSurface = getGeomPlane(face);
+    if (planeSurface.IsNull())
+        return false;
+    // unsigned distance of the plane from the origin, which doesn't depend on the
+    // orientation of the normal. Opposite planes share a key but isEqual() tells them apart.
+    gp_Pln plane(planeSurface->Pln());
+    key = fabs(plane.Position().Direction().XYZ().Dot(plane.Location().XYZ()));
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedPlane::getType() const
 {
     return GeomAbs_Plane;
@@ -477,6 +560,21 @@ bool FaceTypedCylinder::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &f
     return true;
 }
 
+bool FaceTypedCylinder::getEqualityKey(const TopoDS_Face &face, double &key) const
+{
+    Handle(Geom_CylindricalSurface) surface = getGeomCylinder(face);
+    if (surface.IsNull())
+        return false;
+    // radius plus the projection of the axis point closest to the origin, which
+    // is the same for coaxial cylinders regardless of their axis orientation
+    gp_Ax1 axis = surface->Cylinder().Axis();
+    gp_XYZ location = axis.Location().XYZ();
+    gp_XYZ direction = axis.Direction().XYZ();
+    gp_XYZ closest = location - direction * location.Dot(direction);
+    key = surface->Radius() + closest.Dot(keyDirection.XYZ());
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedCylinder::getType() const
 {
     return GeomAbs_Cylinder;
@@ -1166,16 +1264,27 @@ bool FaceUniter::process()
         // update the list of modifications
         TopTools_DataMapOfShapeShape faceMap;
         edgeFuse.Faces(faceMap);
+        // Group the modifications by new face, so that each fused face finds the
+        // modifications it replaces without scanning all of them
+        TopTools_IndexedMapOfShape newFaces;
+        std::vector<std::vector<std::size_t>> modificationsByFace(1);
+        for (std::size_t index = 0; index < modifiedShapes.size(); ++index)
+        {
+            // Note: the map uses IsSame(), IsEqual() for some reason does not work
+            int faceIndex = newFaces.Add(modifiedShapes[index].second);
+            if (faceIndex >= static_cast<int>(modificationsByFace.size()))
+                modificationsByFace.resize(faceIndex + 1);
+            modificationsByFace[faceIndex].push_back(index);
+        }
         for (mapIt.Initialize(faceMap); mapIt.More(); mapIt.Next())
         {
             bool isModifiedFace = false;
-            for (auto & it : modifiedShapes)
+            int faceIndex = newFaces.FindIndex(mapIt.Key());
+            if (faceIndex > 0)
             {
-                if (mapIt.Key().IsSame(it.second)) {
-                    // Note: IsEqual() for some reason does not work
-                    it.second = mapIt.Value();
-                    isModifiedFace = true;
-                }
+                for (std::size_t index : modificationsByFace[faceIndex])
+                    modifiedShapes[index].second = mapIt.Value();
+                isModifiedFace = !modificationsByFace[faceIndex].empty();
             }
             if (!isModifiedFace)
             {
@@ -63,8 +63,13 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const = 0;
         virtual GeomAbs_SurfaceType getType() const = 0;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const = 0;
+        // Scalar key used to hash faces into buckets of width equalityKeyWidth.
+        // Faces that are equal according to isEqual() must have keys closer than
+        // equalityKeyWidth. Returns false if there is no key for this face.
+        virtual bool getEqualityKey(const TopoDS_Face &face, double &key) const;
 
         static GeomAbs_SurfaceType getFaceType(const TopoDS_Face &faceIn);
+        static constexpr double equalityKeyWidth = 1e-2;
 
     protected:
         virtual void boundarySplit(const FaceVectorType &facesIn, std::vector<EdgeVectorType> &boundariesOut) const;
@@ -79,6 +84,7 @@ namespace ModelRefine
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
+        bool getEqualityKey(const TopoDS_Face &face, double &key) const override;
         friend FaceTypedPlane& getPlaneObject();
     };
     FaceTypedPlane& getPlaneObject();
@@ -91,6 +97,7 @@ namespace ModelRefine
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
+        bool getEqualityKey(const TopoDS_Face &face, double &key) const override;
         friend FaceTypedCylinder& getCylinderObject();
 
     protected:
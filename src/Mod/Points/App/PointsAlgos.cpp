@@ -25,13 +25,22 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <sstream>
+#include <thread>
+
+#include <QFile>
+#include <QFuture>
+#include <QtConcurrentMap>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>  // needed for compilation on some systems
-#include <boost/regex.hpp>
 #endif
 
 #include <Base/Console.h>
@@ -47,79 +56,575 @@
 
 using namespace Points;
 
-void PointsAlgos::Load(PointKernel& points, const char* FileName)
+namespace
 {
-    Base::FileInfo File(FileName);
+/** Maps a file into memory for reading. */
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& filename)
+        : file(QString::fromUtf8(filename.c_str()))
+    {
+        if (!file.open(QIODevice::ReadOnly)) {
+            throw Base::FileException("Failed to open file", filename);
+        }
+        if (file.size() > 0) {
+            data = reinterpret_cast<const char*>(file.map(0, file.size()));  // NOLINT
+            if (!data) {
+                throw Base::FileException("Failed to map file", filename);
+            }
+            size = static_cast<std::size_t>(file.size());
+        }
+    }
 
-    // checking on the file
-    if (!File.isReadable()) {
-        throw Base::FileException("File to load not existing or not readable", FileName);
+    const char* begin() const
+    {
+        return data;
+    }
+    const char* end() const
+    {
+        return data + size;  // NOLINT
     }
 
-    if (File.hasExtension("asc")) {
-        LoadAscii(points, FileName);
+private:
+    QFile file;
+    const char* data {nullptr};
+    std::size_t size {0};
+};
+
+using TextChunk = std::pair<const char*, const char*>;
+
+/** Splits the text into chunks of whole lines that can be parsed independently. */
+std::vector<TextChunk> splitLines(const char* begin, const char* end)
+{
+    const std::size_t minChunkSize = 1 << 20;
+    const std::size_t size = end - begin;
+    const auto numThreads = std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t numChunks =
+        std::max<std::size_t>(1, std::min<std::size_t>(4 * numThreads, size / minChunkSize));
+
+    std::vector<TextChunk> chunks;
+    const char* pos = begin;
+    for (std::size_t i = 1; i <= numChunks && pos < end; i++) {
+        const char* next = std::max(pos, begin + i * size / numChunks);
+        next = std::find(next, end, '\n');
+        if (next != end) {
+            ++next;
+        }
+        chunks.emplace_back(pos, next);
+        pos = next;
+    }
+    return chunks;
+}
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool isBlank(const char* begin, const char* end)
+{
+    return std::all_of(begin, end, isSpace);
+}
+
+/** Copies the line starting at \a pos into \a line and returns the start of the next line. */
+const char* getLine(const char* pos, const char* end, std::string& line)
+{
+    const char* eol = std::find(pos, end, '\n');
+    line.assign(pos, eol);
+    return eol == end ? end : eol + 1;
+}
+
+/**
+ * Parses up to \a count numbers of \a line into \a values and returns their number in \a num.
+ * Returns false if the line contains something else than numbers.
+ */
+bool parseNumbers(const std::string& line, double* values, std::size_t count, std::size_t& num)
+{
+    const char* str = line.c_str();
+    for (num = 0; num < count; num++) {
+        char* next {};
+        double value = std::strtod(str, &next);
+        if (next == str) {
+            return isBlank(str, line.c_str() + line.size());
+        }
+        values[num] = value;  // NOLINT
+        str = next;
     }
-    else {
-        throw Base::RuntimeError("Unknown ending");
+    return true;
+}
+
+constexpr std::size_t noField = std::numeric_limits<std::size_t>::max();
+
+std::size_t findField(const std::vector<std::string>& fields,
+                      std::initializer_list<const char*> names)
+{
+    for (const char* name : names) {
+        auto it = std::find(fields.begin(), fields.end(), name);
+        if (it != fields.end()) {
+            return std::distance(fields.begin(), it);
+        }
     }
+    return noField;
 }
 
-void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
+/**
+ * Writes the values of a vertex record of a PLY or PCD file directly to the point,
+ * normal, intensity and color arrays of a reader.
+ */
+struct RecordTarget
 {
-    boost::regex rx("^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                    "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                    "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    // boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    // boost::regex
-    // rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
-
-    Base::Vector3d pt;
-    int LineCnt = 0;
-    std::string line;
-    Base::FileInfo fi(FileName);
+    enum ColorFormat
+    {
+        NoColor,
+        ByteRGBA,
+        FloatRGBA,
+        PackedUInt,
+        PackedFloat
+    };
+
+    explicit RecordTarget(const std::vector<std::string>& fields)
+        : x(findField(fields, {"x"}))
+        , y(findField(fields, {"y"}))
+        , z(findField(fields, {"z"}))
+        , nx(findField(fields, {"normal_x", "nx"}))
+        , ny(findField(fields, {"normal_y", "ny"}))
+        , nz(findField(fields, {"normal_z", "nz"}))
+        , grey(findField(fields, {"intensity"}))
+    {}
+
+    bool hasPoints() const
+    {
+        return x != noField && y != noField && z != noField;
+    }
+    bool hasNormals() const
+    {
+        return nx != noField && ny != noField && nz != noField;
+    }
 
-    Base::ifstream tmp_str(fi, std::ios::in);
+    void allocate(std::size_t numPoints,
+                  PointKernel& pts,
+                  std::vector<Base::Vector3f>& nor,
+                  std::vector<float>& inten,
+                  std::vector<App::Color>& col)
+    {
+        pts.resize(numPoints);
+        points = &pts;
+        if (hasNormals()) {
+            nor.resize(numPoints);
+            normals = nor.data();
+        }
+        if (grey != noField) {
+            inten.resize(numPoints);
+            intensity = inten.data();
+        }
+        if (colorFormat != NoColor) {
+            col.resize(numPoints);
+            colors = col.data();
+        }
+    }
 
-    // estimating size
-    while (std::getline(tmp_str, line)) {
-        LineCnt++;
+    // NOLINTBEGIN
+    void assign(std::size_t row, const double* values) const
+    {
+        points->setPoint(static_cast<int>(row), Base::Vector3d(values[x], values[y], values[z]));
+        if (normals) {
+            normals[row].Set(static_cast<float>(values[nx]),
+                             static_cast<float>(values[ny]),
+                             static_cast<float>(values[nz]));
+        }
+        if (intensity) {
+            intensity[row] = static_cast<float>(values[grey]);
+        }
+
+        switch (colorFormat) {
+            case ByteRGBA: {
+                float a = alpha != noField ? static_cast<float>(values[alpha]) : 1.0F;
+                colors[row].set(static_cast<float>(values[red]) / 255.0F,
+                                static_cast<float>(values[green]) / 255.0F,
+                                static_cast<float>(values[blue]) / 255.0F,
+                                a / 255.0F);
+            } break;
+            case FloatRGBA: {
+                float a = alpha != noField ? static_cast<float>(values[alpha]) : 1.0F;
+                colors[row].set(static_cast<float>(values[red]),
+                                static_cast<float>(values[green]),
+                                static_cast<float>(values[blue]),
+                                a);
+            } break;
+            case PackedUInt:
+                colors[row].setPackedARGB(static_cast<uint32_t>(values[red]));
+                break;
+            case PackedFloat: {
+                static_assert(sizeof(float) == sizeof(uint32_t),
+                              "float and uint32_t have different sizes");
+                float f = static_cast<float>(values[red]);
+                uint32_t packed {};
+                std::memcpy(&packed, &f, sizeof(packed));
+                colors[row].setPackedARGB(packed);
+            } break;
+            default:
+                break;
+        }
     }
+    // NOLINTEND
 
-    // resize the PointKernel
-    points.resize(LineCnt);
+    std::size_t x, y, z;
+    std::size_t nx, ny, nz;
+    std::size_t grey;
+    // for packed colors only 'red' is used
+    std::size_t red {noField}, green {noField}, blue {noField}, alpha {noField};
+    ColorFormat colorFormat {NoColor};
 
-    Base::SequencerLauncher seq("Loading points...", LineCnt);
+    PointKernel* points {nullptr};
+    Base::Vector3f* normals {nullptr};
+    float* intensity {nullptr};
+    App::Color* colors {nullptr};
+};
 
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
+struct AsciiChunk
+{
+    TextChunk text;
+    std::size_t firstRow {0};
+    std::size_t numRows {0};
+    bool failed {false};
+};
 
+/** Counts the lines of \a chunk that are not blank. */
+void countRecords(AsciiChunk& chunk)
+{
+    std::string line;
+    for (const char* pos = chunk.text.first; pos < chunk.text.second;) {
+        const char* next = getLine(pos, chunk.text.second, line);
+        if (!isBlank(pos, next)) {
+            chunk.numRows++;
+        }
+        pos = next;
+    }
+}
+
+constexpr std::size_t parseFailed = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Writes the points of \a chunk to \a points starting at its first row and returns their
+ * number, or parseFailed. Only lines with exactly three numbers are points.
+ */
+std::size_t parseAsciiPoints(const AsciiChunk& chunk, PointKernel* points)
+{
     try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
-
-                points.setPoint(LineCnt, pt);
-                seq.next();
-                LineCnt++;
+        std::size_t row = chunk.firstRow;
+        std::string line;
+        std::array<double, 4> values {};
+        for (const char* pos = chunk.text.first; pos < chunk.text.second;) {
+            pos = getLine(pos, chunk.text.second, line);
+            std::size_t num {};
+            if (parseNumbers(line, values.data(), values.size(), num) && num == 3) {
+                points->setPoint(static_cast<int>(row++),
+                                 Base::Vector3d(values[0], values[1], values[2]));
             }
         }
+        return row - chunk.firstRow;
     }
     catch (...) {
-        points.clear();
-        throw Base::BadFormatError("Reading in points failed.");
+        return parseFailed;
+    }
+}
+
+/** Parses the records of an ASCII file in parallel. Blank lines are skipped. */
+void readAsciiRecords(const char* begin,
+                      const char* end,
+                      std::size_t numFields,
+                      std::size_t numPoints,
+                      const RecordTarget& target)
+{
+    std::vector<AsciiChunk> chunks;
+    for (const auto& text : splitLines(begin, end)) {
+        chunks.push_back({text});
+    }
+
+    // count the records of each chunk to get the row of its first record
+    QtConcurrent::blockingMap(chunks, &countRecords);
+
+    std::size_t row = 0;
+    for (auto& chunk : chunks) {
+        chunk.firstRow = row;
+        row += chunk.numRows;
+    }
+
+    QtConcurrent::blockingMap(chunks, [numFields, numPoints, &target](AsciiChunk& chunk) {
+        std::string line;
+        std::vector<double> values(numFields);
+        std::size_t row = chunk.firstRow;
+        for (const char* pos = chunk.text.first; pos < chunk.text.second && row < numPoints;) {
+            const char* next = getLine(pos, chunk.text.second, line);
+            if (!isBlank(pos, next)) {
+                std::size_t num {};
+                if (!parseNumbers(line, values.data(), numFields, num)) {
+                    chunk.failed = true;
+                    return;
+                }
+                std::fill(values.begin() + static_cast<std::ptrdiff_t>(num), values.end(), 0.0);
+                target.assign(row++, values.data());
+            }
+            pos = next;
+        }
+    });
+
+    if (std::any_of(chunks.begin(), chunks.end(), [](const AsciiChunk& chunk) {
+            return chunk.failed;
+        })) {
+        throw Base::BadFormatError("Invalid number in point record");
+    }
+}
+
+enum class FieldType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+FieldType plyFieldType(const std::string& type)
+{
+    if (type == "char" || type == "int8") {
+        return FieldType::Int8;
+    }
+    if (type == "uchar" || type == "uint8") {
+        return FieldType::UInt8;
+    }
+    if (type == "short" || type == "int16") {
+        return FieldType::Int16;
+    }
+    if (type == "ushort" || type == "uint16") {
+        return FieldType::UInt16;
+    }
+    if (type == "int" || type == "int32") {
+        return FieldType::Int32;
+    }
+    if (type == "uint" || type == "uint32") {
+        return FieldType::UInt32;
+    }
+    if (type == "float" || type == "float32") {
+        return FieldType::Float32;
+    }
+    if (type == "double" || type == "float64") {
+        return FieldType::Float64;
+    }
+    throw Base::BadFormatError("Unexpected type");
+}
+
+FieldType pcdFieldType(const std::string& type, int size)
+{
+    char t = type.empty() ? ' ' : type[0];
+    switch (size) {
+        case 1:
+            if (t == 'I') {
+                return FieldType::Int8;
+            }
+            if (t == 'U') {
+                return FieldType::UInt8;
+            }
+            break;
+        case 2:
+            if (t == 'I') {
+                return FieldType::Int16;
+            }
+            if (t == 'U') {
+                return FieldType::UInt16;
+            }
+            break;
+        case 4:
+            if (t == 'I') {
+                return FieldType::Int32;
+            }
+            if (t == 'U') {
+                return FieldType::UInt32;
+            }
+            if (t == 'F') {
+                return FieldType::Float32;
+            }
+            break;
+        case 8:
+            if (t == 'F') {
+                return FieldType::Float64;
+            }
+            break;
+        default:
+            break;
+    }
+    throw Base::BadFormatError("Unexpected type");
+}
+
+/** The position of a property inside binary data. */
+struct BinaryField
+{
+    FieldType type {FieldType::Float32};
+    std::size_t size {0};
+    /// position of the value of the first record
+    std::size_t offset {0};
+    /// distance between the values of two consecutive records
+    std::size_t stride {0};
+};
+
+template<typename T>
+double readValue(const char* ptr, bool swapByteOrder)
+{
+    std::array<char, sizeof(T)> bytes {};
+    std::memcpy(bytes.data(), ptr, sizeof(T));
+    if (swapByteOrder) {
+        std::reverse(bytes.begin(), bytes.end());
+    }
+    T value {};
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    return static_cast<double>(value);
+}
+
+double readValue(const BinaryField& field, const char* ptr, bool swapByteOrder)
+{
+    switch (field.type) {
+        case FieldType::Int8:
+            return readValue<int8_t>(ptr, swapByteOrder);
+        case FieldType::UInt8:
+            return readValue<uint8_t>(ptr, swapByteOrder);
+        case FieldType::Int16:
+            return readValue<int16_t>(ptr, swapByteOrder);
+        case FieldType::UInt16:
+            return readValue<uint16_t>(ptr, swapByteOrder);
+        case FieldType::Int32:
+            return readValue<int32_t>(ptr, swapByteOrder);
+        case FieldType::UInt32:
+            return readValue<uint32_t>(ptr, swapByteOrder);
+        case FieldType::Float32:
+            return readValue<float>(ptr, swapByteOrder);
+        case FieldType::Float64:
+            return readValue<double>(ptr, swapByteOrder);
+    }
+    return 0.0;
+}
+
+/** Sets offset and stride of the fields for records that are stored one after another. */
+std::size_t setRowLayout(std::vector<BinaryField>& fields)
+{
+    std::size_t recordSize = 0;
+    for (auto& field : fields) {
+        field.offset = recordSize;
+        recordSize += field.size;
+    }
+    for (auto& field : fields) {
+        field.stride = recordSize;
+    }
+    return recordSize;
+}
+
+/** Sets offset and stride of the fields for data that is stored field by field. */
+std::size_t setColumnLayout(std::vector<BinaryField>& fields, std::size_t numPoints)
+{
+    std::size_t offset = 0;
+    for (auto& field : fields) {
+        field.offset = offset;
+        field.stride = field.size;
+        offset += field.size * numPoints;
+    }
+    return offset;
+}
+
+/** Decodes binary records in parallel. */
+void readBinaryRecords(const char* data,
+                       const std::vector<BinaryField>& fields,
+                       bool swapByteOrder,
+                       std::size_t numPoints,
+                       const RecordTarget& target)
+{
+    const std::size_t blockSize = 65536;
+    std::vector<std::pair<std::size_t, std::size_t>> blocks;
+    for (std::size_t row = 0; row < numPoints; row += blockSize) {
+        blocks.emplace_back(row, std::min(row + blockSize, numPoints));
+    }
+
+    QtConcurrent::blockingMap(blocks, [&](std::pair<std::size_t, std::size_t>& block) {
+        std::vector<double> values(fields.size());
+        for (std::size_t row = block.first; row < block.second; row++) {
+            for (std::size_t j = 0; j < fields.size(); j++) {
+                const BinaryField& field = fields[j];
+                values[j] =
+                    readValue(field, data + field.offset + row * field.stride, swapByteOrder);
+            }
+            target.assign(row, values.data());
+        }
+    });
+}
+}  // namespace
+
+void PointsAlgos::Load(PointKernel& points, const char* FileName)
+{
+    Base::FileInfo File(FileName);
+
+    // checking on the file
+    if (!File.isReadable()) {
+        throw Base::FileException("File to load not existing or not readable", FileName);
+    }
+
+    if (File.hasExtension("asc")) {
+        LoadAscii(points, FileName);
+    }
+    else {
+        throw Base::RuntimeError("Unknown ending");
     }
+}
 
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size()) {
-        points.erase(LineCnt, points.size());
+void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
+{
+    MappedFile file(FileName);
+    std::vector<AsciiChunk> chunks;
+    for (const auto& text : splitLines(file.begin(), file.end())) {
+        chunks.push_back({text});
     }
+
+    // Every non-blank line may be a point, so this gives the first row of each chunk
+    QtConcurrent::blockingMap(chunks, &countRecords);
+    std::size_t row = 0;
+    for (auto& chunk : chunks) {
+        chunk.firstRow = row;
+        row += chunk.numRows;
+    }
+
+    points.clear();
+    points.resize(row);
+
+    Base::SequencerLauncher seq("Loading points...", chunks.size());
+
+    // The chunks are parsed in parallel directly into the kernel. Lines that are not points
+    // leave a gap at the end of their chunk, so each finished chunk is moved down to the end
+    // of the previous one. This only touches the rows of finished chunks.
+    // NOLINTBEGIN
+    QFuture<std::size_t> future =
+        QtConcurrent::mapped(chunks, std::bind(&parseAsciiPoints, std::placeholders::_1, &points));
+    // NOLINTEND
+    std::vector<PointKernel::value_type>& pnts = points.getBasicPoints();
+    std::size_t numPoints = 0;
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        std::size_t count = future.resultAt(static_cast<int>(i));
+        if (count == parseFailed) {
+            // the other chunks still write to the kernel
+            future.waitForFinished();
+            points.clear();
+            throw Base::BadFormatError("Reading in points failed.");
+        }
+        auto first = pnts.begin() + static_cast<std::ptrdiff_t>(chunks[i].firstRow);
+        if (chunks[i].firstRow != numPoints) {
+            std::copy(first,
+                      first + static_cast<std::ptrdiff_t>(count),
+                      pnts.begin() + static_cast<std::ptrdiff_t>(numPoints));
+        }
+        numPoints += count;
+        seq.next();
+    }
+    points.erase(numPoints, points.size());
 }
 
 // ----------------------------------------------------------------------------
@@ -246,90 +751,6 @@ public:
 
 using ConverterPtr = std::shared_ptr<Converter>;
 
-class DataStreambuf: public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data)
-        : _buffer(data)
-        , _end(int(data.size()))
-    {}
-    ~DataStreambuf() override = default;
-
-protected:
-    int_type uflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    int_type underflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    int_type pbackfail(int_type ch) override
-    {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur - 1])) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    std::streamsize showmanyc() override
-    {
-        return _end - _cur;
-    }
-    pos_type seekoff(std::streambuf::off_type off,
-                     std::ios_base::seekdir way,
-                     std::ios_base::openmode mode = std::ios::in | std::ios::out) override
-    {
-        (void)mode;
-        int p_pos = -1;
-        if (way == std::ios_base::beg) {
-            p_pos = _beg;
-        }
-        else if (way == std::ios_base::end) {
-            p_pos = _end;
-        }
-        else if (way == std::ios_base::cur) {
-            p_pos = _cur;
-        }
-
-        if (p_pos > _end) {
-            return traits_type::eof();
-        }
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg)) {
-            return traits_type::eof();
-        }
-
-        _cur = p_pos + off;
-
-        return ((p_pos + off) - _beg);
-    }
-    pos_type seekpos(std::streambuf::pos_type pos,
-                     std::ios_base::openmode which = std::ios::in | std::ios::out) override
-    {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-public:
-    DataStreambuf(const DataStreambuf&) = delete;
-    DataStreambuf(DataStreambuf&&) = delete;
-    DataStreambuf& operator=(const DataStreambuf&) = delete;
-    DataStreambuf& operator=(DataStreambuf&&) = delete;
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg {0}, _end {0}, _cur {0};
-};
-
 // NOLINTBEGIN
 // Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int
@@ -549,171 +970,76 @@ void PlyReader::read(const std::string& filename)
 {
     clear();
 
-    Base::FileInfo fi(filename);
-    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
-
     std::string format;
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
     std::size_t offset = 0;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, offset, fields, types, sizes));
-
-    this->width = numPoints;
-    this->height = 1;
-
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::find(fields.begin(), fields.end(), "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::find(fields.begin(), fields.end(), "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::find(fields.begin(), fields.end(), "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_x");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
-
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_y");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_z");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
-
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::find(fields.begin(), fields.end(), "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
+    std::size_t numPoints = 0;
+    std::streamoff headerSize = 0;
+    {
+        Base::FileInfo fi(filename);
+        Base::ifstream inp(fi, std::ios::in | std::ios::binary);
+        numPoints = readHeader(inp, format, offset, fields, types, sizes);
+        headerSize = inp.tellg();
     }
 
-    // rgb(a) field
-    Eigen::Index red = max_size;
-    Eigen::Index green = max_size;
-    Eigen::Index blue = max_size;
-    Eigen::Index alpha = max_size;
-    it = std::find(fields.begin(), fields.end(), "red");
-    if (it != fields.end()) {
-        red = std::distance(fields.begin(), it);
-    }
+    this->width = static_cast<int>(numPoints);
+    this->height = 1;
 
-    it = std::find(fields.begin(), fields.end(), "green");
-    if (it != fields.end()) {
-        green = std::distance(fields.begin(), it);
+    RecordTarget target(fields);
+    target.red = findField(fields, {"red"});
+    target.green = findField(fields, {"green"});
+    target.blue = findField(fields, {"blue"});
+    target.alpha = findField(fields, {"alpha"});
+    if (target.red != noField && target.green != noField && target.blue != noField) {
+        if (types[target.red] == "uchar") {
+            target.colorFormat = RecordTarget::ByteRGBA;
+        }
+        else if (types[target.red] == "float") {
+            target.colorFormat = RecordTarget::FloatRGBA;
+        }
     }
 
-    it = std::find(fields.begin(), fields.end(), "blue");
-    if (it != fields.end()) {
-        blue = std::distance(fields.begin(), it);
+    if (!target.hasPoints() || numPoints == 0) {
+        return;
     }
 
-    it = std::find(fields.begin(), fields.end(), "alpha");
-    if (it != fields.end()) {
-        alpha = std::distance(fields.begin(), it);
+    if (headerSize < 0) {
+        throw Base::BadFormatError("Missing point data");
     }
 
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
+    // the values are written directly to the final arrays
+    MappedFile file(filename);
+    const char* data = file.begin() + headerSize;
+    target.allocate(numPoints, points, normals, intensity, colors);
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    if (format == "ascii") {
+        // skip the lines of the elements before the vertices
+        std::string line;
+        while (offset > 0 && data < file.end()) {
+            const char* next = getLine(data, file.end(), line);
+            if (!isBlank(data, next)) {
+                offset--;
+            }
+            data = next;
         }
+        readAsciiRecords(data, file.end(), fields.size(), numPoints, target);
     }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+    else {
+        std::vector<BinaryField> binary;
+        for (std::size_t j = 0; j < fields.size(); j++) {
+            binary.push_back({plyFieldType(types[j]), static_cast<std::size_t>(sizes[j])});
         }
-    }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
+        std::size_t neededSize = setRowLayout(binary) * numPoints;
+        data += offset;
+        if (data > file.end() || static_cast<std::size_t>(file.end() - data) < neededSize) {
+            clear();
+            throw Base::BadFormatError("File expects too many elements");
         }
-    }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(static_cast<float>(r) / 255.0F,
-                                    static_cast<float>(g) / 255.0F,
-                                    static_cast<float>(b) / 255.0F,
-                                    static_cast<float>(a) / 255.0F);
-            }
-        }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(r, g, b, a);
-            }
-        }
+        readBinaryRecords(data, binary, format == "binary_big_endian", numPoints, target);
     }
 }
 
@@ -887,136 +1213,6 @@ std::size_t PlyReader::readHeader(std::istream& in,
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PlyReader::readBinary(bool swapByteOrder,
-                           std::istream& inp,
-                           std::size_t offset,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        const std::string& t = types[j];
-        switch (sizes[j]) {
-            case 1:
-                if (t == "char" || t == "int8") {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == "uchar" || t == "uint8") {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == "short" || t == "int16") {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == "ushort" || t == "uint16") {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == "int" || t == "int32") {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == "uint" || t == "uint32") {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == "float" || t == "float32") {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == "double" || t == "float64") {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 PcdReader::PcdReader() = default;
@@ -1027,162 +1223,83 @@ void PcdReader::read(const std::string& filename)
     this->width = 0;
     this->height = 1;
 
-    Base::FileInfo fi(filename);
-    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
-
     std::string format;
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
-
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
+    std::size_t numPoints = 0;
+    std::streamoff headerSize = 0;
+    {
+        Base::FileInfo fi(filename);
+        Base::ifstream inp(fi, std::ios::in | std::ios::binary);
+        numPoints = readHeader(inp, format, fields, types, sizes);
+        headerSize = inp.tellg();
     }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
 
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
+    RecordTarget target(fields);
+    target.red = findField(fields, {"rgb", "rgba"});
+    if (target.red != noField) {
+        if (types[target.red] == "U") {
+            target.colorFormat = RecordTarget::PackedUInt;
         }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
+        else if (types[target.red] == "F") {
+            target.colorFormat = RecordTarget::PackedFloat;
         }
     }
 
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::find(fields.begin(), fields.end(), "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::find(fields.begin(), fields.end(), "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
+    if (!target.hasPoints() || numPoints == 0) {
+        return;
     }
 
-    // z field
-    Eigen::Index z = max_size;
-    it = std::find(fields.begin(), fields.end(), "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_x");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
+    std::vector<BinaryField> binary;
+    if (format != "ascii") {
+        for (std::size_t j = 0; j < fields.size(); j++) {
+            binary.push_back(
+                {pcdFieldType(types[j], sizes[j]), static_cast<std::size_t>(sizes[j])});
+        }
     }
 
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_y");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
+    if (headerSize < 0) {
+        throw Base::BadFormatError("Missing point data");
     }
 
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_z");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
+    // the values are written directly to the final arrays
+    MappedFile file(filename);
+    const char* data = file.begin() + headerSize;
+    std::size_t available = data < file.end() ? file.end() - data : 0;
+    target.allocate(numPoints, points, normals, intensity, colors);
 
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::find(fields.begin(), fields.end(), "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
-    }
-
-    // rgb(a) field
-    Eigen::Index rgba = max_size;
-    it = std::find(fields.begin(), fields.end(), "rgb");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "rgba");
-    }
-    if (it != fields.end()) {
-        rgba = std::distance(fields.begin(), it);
+    if (format == "ascii") {
+        readAsciiRecords(data, file.end(), fields.size(), numPoints, target);
     }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    else if (format == "binary") {
+        if (available < setRowLayout(binary) * numPoints) {
+            clear();
+            throw Base::BadFormatError("File expects too many elements");
         }
+        readBinaryRecords(data, binary, false, numPoints, target);
     }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+    else if (format == "binary_compressed") {
+        if (available < 2 * sizeof(uint32_t)) {
+            clear();
+            throw Base::BadFormatError("Failed to decompress binary data");
         }
-    }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
-        }
-    }
+        uint32_t c {};
+        uint32_t u {};
+        std::memcpy(&c, data, sizeof(c));
+        std::memcpy(&u, data + sizeof(c), sizeof(u));
+        data += 2 * sizeof(uint32_t);
+        available -= 2 * sizeof(uint32_t);
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                App::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
-        }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t),
-                          "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                App::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
+        // the uncompressed data is stored field by field
+        std::vector<char> uncompressed(u);
+        if (c > available || lzfDecompress(data, c, uncompressed.data(), u) != u
+            || u < setColumnLayout(binary, numPoints)) {
+            clear();
+            throw Base::BadFormatError("Failed to decompress binary data");
         }
+        readBinaryRecords(uncompressed.data(), binary, false, numPoints, target);
     }
 }
 
@@ -1257,139 +1374,6 @@ std::size_t PcdReader::readHeader(std::istream& in,
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PcdReader::readBinary(bool transpose,
-                           std::istream& inp,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        char t = types[j][0];
-        switch (sizes[j]) {
-            case 1:
-                if (t == 'I') {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == 'I') {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == 'I') {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == 'F') {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == 'F') {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 namespace
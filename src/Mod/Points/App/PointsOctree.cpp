@@ -0,0 +1,452 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <thread>
+#include <utility>
+
+#include <QtConcurrentMap>
+#endif
+
+#include "PointsOctree.h"
+
+
+using namespace Points;
+
+namespace
+{
+// 21 bits per axis fill a 63 bit Morton code
+constexpr int bitsPerAxis = 21;
+constexpr std::uint64_t cellsPerAxis = std::uint64_t(1) << bitsPerAxis;
+
+// Inserts two zero bits after each of the lower 21 bits of v
+std::uint64_t spreadBits(std::uint64_t v)
+{
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffff;
+    v = (v | v << 16) & 0x1f0000ff0000ff;
+    v = (v | v << 8) & 0x100f00f00f00f00f;
+    v = (v | v << 4) & 0x10c30c30c30c30c3;
+    v = (v | v << 2) & 0x1249249249249249;
+    return v;
+}
+
+std::uint64_t quantize(float value, double min, double scale)
+{
+    double cell = (value - min) * scale;
+    return std::min<std::uint64_t>(cellsPerAxis - 1, static_cast<std::uint64_t>(cell));
+}
+
+bool isValid(const Base::Vector3f& pnt)
+{
+    return !std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z);
+}
+
+double distanceSquared(const Base::Vector3f& pnt, const Base::Vector3f& other)
+{
+    double dx = pnt.x - other.x;
+    double dy = pnt.y - other.y;
+    double dz = pnt.z - other.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// squared distance of a point to a box, zero if the point is inside
+double distanceSquared(const Base::Vector3f& pnt, const Base::BoundBox3d& box)
+{
+    auto axis = [](double value, double min, double max) {
+        if (value < min) {
+            return min - value;
+        }
+        if (value > max) {
+            return value - max;
+        }
+        return 0.0;
+    };
+    double dx = axis(pnt.x, box.MinX, box.MaxX);
+    double dy = axis(pnt.y, box.MinY, box.MaxY);
+    double dz = axis(pnt.z, box.MinZ, box.MaxZ);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+using Neighbour = std::pair<double, unsigned long>;
+
+void splitNeighbours(const std::vector<Neighbour>& neighbours,
+                     std::vector<unsigned long>& indices,
+                     std::vector<float>& distances)
+{
+    indices.clear();
+    distances.clear();
+    indices.reserve(neighbours.size());
+    distances.reserve(neighbours.size());
+    for (const auto& it : neighbours) {
+        indices.push_back(it.second);
+        distances.push_back(static_cast<float>(std::sqrt(it.first)));
+    }
+}
+
+// splits the range [0, size) into blocks that are processed in parallel
+std::vector<std::pair<std::size_t, std::size_t>> makeBlocks(std::size_t size)
+{
+    const std::size_t minBlockSize = 1024;
+    const auto numThreads = std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t numBlocks =
+        std::max<std::size_t>(1, std::min<std::size_t>(4 * numThreads, size / minBlockSize));
+
+    std::vector<std::pair<std::size_t, std::size_t>> blocks;
+    for (std::size_t i = 0; i < numBlocks; i++) {
+        blocks.emplace_back(i * size / numBlocks, (i + 1) * size / numBlocks);
+    }
+    return blocks;
+}
+}  // namespace
+
+PointsOctree::PointsOctree(const PointKernel& kernel, unsigned long leafSize)
+    : _kernel(&kernel)
+    , _leafSize(leafSize)
+{
+    Rebuild(leafSize);
+}
+
+void PointsOctree::Rebuild(unsigned long leafSize)
+{
+    _leafSize = std::max<unsigned long>(leafSize, 1);
+    _box = Base::BoundBox3d();
+    _indices.clear();
+    _nodes.clear();
+
+    const std::vector<PointKernel::value_type>& points = _kernel->getBasicPoints();
+    for (const auto& pnt : points) {
+        if (isValid(pnt)) {
+            _box.Add(Base::Vector3d(pnt.x, pnt.y, pnt.z));
+        }
+    }
+
+    if (!_box.IsValid()) {
+        return;
+    }
+
+    auto scale = [](double len) {
+        return len > 0.0 ? static_cast<double>(cellsPerAxis) / len : 0.0;
+    };
+    double scaleX = scale(_box.LengthX());
+    double scaleY = scale(_box.LengthY());
+    double scaleZ = scale(_box.LengthZ());
+
+    std::vector<std::pair<std::uint64_t, unsigned long>> keys;
+    keys.reserve(points.size());
+    for (std::size_t index = 0; index < points.size(); index++) {
+        const auto& pnt = points[index];
+        if (isValid(pnt)) {
+            std::uint64_t code = spreadBits(quantize(pnt.x, _box.MinX, scaleX)) << 2
+                | spreadBits(quantize(pnt.y, _box.MinY, scaleY)) << 1
+                | spreadBits(quantize(pnt.z, _box.MinZ, scaleZ));
+            keys.emplace_back(code, static_cast<unsigned long>(index));
+        }
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::uint64_t> codes;
+    codes.reserve(keys.size());
+    _indices.reserve(keys.size());
+    for (const auto& it : keys) {
+        codes.push_back(it.first);
+        _indices.push_back(it.second);
+    }
+
+    Node root;
+    root.end = static_cast<unsigned long>(_indices.size());
+    _nodes.push_back(root);
+    Split(0, 0, codes);
+}
+
+Base::BoundBox3d
+PointsOctree::Split(unsigned long node, int depth, const std::vector<std::uint64_t>& codes)
+{
+    // the node array may grow while the children are split, so don't keep references into it
+    unsigned long begin = _nodes[node].begin;
+    unsigned long end = _nodes[node].end;
+    Base::BoundBox3d box;
+
+    if (end - begin <= _leafSize || depth == bitsPerAxis) {
+        const std::vector<PointKernel::value_type>& points = _kernel->getBasicPoints();
+        for (unsigned long i = begin; i < end; i++) {
+            const auto& pnt = points[_indices[i]];
+            box.Add(Base::Vector3d(pnt.x, pnt.y, pnt.z));
+        }
+        _nodes[node].box = box;
+        return box;
+    }
+
+    // all codes of the node share the same prefix, so the octant is given by the next three bits
+    int shift = 3 * (bitsPerAxis - 1 - depth);
+    auto first = codes.begin() + begin;
+    auto last = codes.begin() + end;
+    auto child = static_cast<unsigned long>(_nodes.size());
+    while (first != last) {
+        auto next = std::upper_bound(first, last, *first | ((std::uint64_t(1) << shift) - 1));
+        Node sub;
+        sub.begin = static_cast<unsigned long>(first - codes.begin());
+        sub.end = static_cast<unsigned long>(next - codes.begin());
+        _nodes.push_back(sub);
+        first = next;
+    }
+
+    auto numChildren = static_cast<unsigned long>(_nodes.size()) - child;
+    _nodes[node].child = child;
+    _nodes[node].numChildren = numChildren;
+    for (unsigned long i = 0; i < numChildren; i++) {
+        box.Add(Split(child + i, depth + 1, codes));
+    }
+
+    _nodes[node].box = box;
+    return box;
+}
+
+void PointsOctree::Inside(const Base::BoundBox3d& box, std::vector<unsigned long>& indices) const
+{
+    if (_nodes.empty()) {
+        return;
+    }
+
+    const std::vector<PointKernel::value_type>& points = _kernel->getBasicPoints();
+    std::vector<unsigned long> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+        if (!box.Intersect(node.box)) {
+            continue;
+        }
+
+        if (box.IsInBox(node.box)) {
+            indices.insert(indices.end(),
+                           _indices.begin() + node.begin,
+                           _indices.begin() + node.end);
+        }
+        else if (node.numChildren == 0) {
+            for (unsigned long i = node.begin; i < node.end; i++) {
+                const auto& pnt = points[_indices[i]];
+                if (box.IsInBox(Base::Vector3d(pnt.x, pnt.y, pnt.z))) {
+                    indices.push_back(_indices[i]);
+                }
+            }
+        }
+        else {
+            for (unsigned long i = 0; i < node.numChildren; i++) {
+                stack.push_back(node.child + i);
+            }
+        }
+    }
+}
+
+std::vector<unsigned long> PointsOctree::GetLevelOfDetail(std::size_t maxPoints) const
+{
+    std::size_t numPoints = _indices.size();
+    if (maxPoints >= numPoints) {
+        return _indices;
+    }
+
+    // Consecutive points along the Morton curve are spatially close, so taking every n-th point
+    // keeps the density distribution of the cloud
+    std::vector<unsigned long> lod;
+    lod.reserve(maxPoints);
+    for (std::size_t i = 0; i < maxPoints; i++) {
+        lod.push_back(_indices[i * numPoints / maxPoints]);
+    }
+
+    return lod;
+}
+
+void PointsOctree::NearestNeighbours(const Base::Vector3f& pnt,
+                                     unsigned long k,
+                                     std::vector<unsigned long>& indices,
+                                     std::vector<float>& distances) const
+{
+    indices.clear();
+    distances.clear();
+    if (_nodes.empty() || k == 0) {
+        return;
+    }
+
+    // Visit the nodes in order of their distance and keep the k best candidates in a max-heap
+    const std::vector<PointKernel::value_type>& points = _kernel->getBasicPoints();
+    std::priority_queue<Neighbour, std::vector<Neighbour>, std::greater<>> queue;
+    std::vector<Neighbour> best;
+    best.reserve(k);
+    queue.emplace(distanceSquared(pnt, _nodes[0].box), 0);
+    while (!queue.empty()) {
+        Neighbour top = queue.top();
+        queue.pop();
+        if (best.size() == k && top.first >= best.front().first) {
+            break;
+        }
+
+        const Node& node = _nodes[top.second];
+        if (node.numChildren == 0) {
+            for (unsigned long i = node.begin; i < node.end; i++) {
+                double dist = distanceSquared(pnt, points[_indices[i]]);
+                if (best.size() < k) {
+                    best.emplace_back(dist, _indices[i]);
+                    std::push_heap(best.begin(), best.end());
+                }
+                else if (dist < best.front().first) {
+                    std::pop_heap(best.begin(), best.end());
+                    best.back() = Neighbour(dist, _indices[i]);
+                    std::push_heap(best.begin(), best.end());
+                }
+            }
+        }
+        else {
+            for (unsigned long i = 0; i < node.numChildren; i++) {
+                unsigned long child = node.child + i;
+                double dist = distanceSquared(pnt, _nodes[child].box);
+                if (best.size() < k || dist < best.front().first) {
+                    queue.emplace(dist, child);
+                }
+            }
+        }
+    }
+
+    std::sort_heap(best.begin(), best.end());
+    splitNeighbours(best, indices, distances);
+}
+
+void PointsOctree::Within(const Base::Vector3f& pnt,
+                          float radius,
+                          std::vector<unsigned long>& indices,
+                          std::vector<float>& distances) const
+{
+    indices.clear();
+    distances.clear();
+    if (_nodes.empty() || radius < 0.0F) {
+        return;
+    }
+
+    const std::vector<PointKernel::value_type>& points = _kernel->getBasicPoints();
+    double radius2 = static_cast<double>(radius) * radius;
+    std::vector<Neighbour> found;
+    std::vector<unsigned long> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+        if (distanceSquared(pnt, node.box) > radius2) {
+            continue;
+        }
+
+        if (node.numChildren == 0) {
+            for (unsigned long i = node.begin; i < node.end; i++) {
+                double dist = distanceSquared(pnt, points[_indices[i]]);
+                if (dist <= radius2) {
+                    found.emplace_back(dist, _indices[i]);
+                }
+            }
+        }
+        else {
+            for (unsigned long i = 0; i < node.numChildren; i++) {
+                stack.push_back(node.child + i);
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    splitNeighbours(found, indices, distances);
+}
+
+unsigned long PointsOctree::NearestNeighbours(const std::vector<Base::Vector3f>& pnts,
+                                              unsigned long k,
+                                              std::vector<unsigned long>& indices,
+                                              std::vector<float>& distances) const
+{
+    k = std::min<unsigned long>(k, static_cast<unsigned long>(_indices.size()));
+    indices.resize(pnts.size() * k);
+    distances.resize(pnts.size() * k);
+    if (k == 0) {
+        return 0;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> blocks = makeBlocks(pnts.size());
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        std::vector<unsigned long> idx;
+        std::vector<float> dist;
+        for (std::size_t i = block.first; i < block.second; i++) {
+            NearestNeighbours(pnts[i], k, idx, dist);
+            std::copy(idx.begin(), idx.end(), indices.begin() + i * k);
+            std::copy(dist.begin(), dist.end(), distances.begin() + i * k);
+        }
+    });
+
+    return k;
+}
+
+void PointsOctree::Within(const std::vector<Base::Vector3f>& pnts,
+                          float radius,
+                          std::vector<std::size_t>& offsets,
+                          std::vector<unsigned long>& indices,
+                          std::vector<float>& distances) const
+{
+    // The number of neighbours isn't known in advance, so each block collects its results first
+    // and they are concatenated afterwards
+    struct Block
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::vector<std::size_t> counts;
+        std::vector<unsigned long> indices;
+        std::vector<float> distances;
+    };
+
+    std::vector<Block> blocks;
+    for (const auto& it : makeBlocks(pnts.size())) {
+        blocks.push_back({it.first, it.second, {}, {}, {}});
+    }
+
+    QtConcurrent::blockingMap(blocks, [&](Block& block) {
+        std::vector<unsigned long> idx;
+        std::vector<float> dist;
+        for (std::size_t i = block.begin; i < block.end; i++) {
+            Within(pnts[i], radius, idx, dist);
+            block.counts.push_back(idx.size());
+            block.indices.insert(block.indices.end(), idx.begin(), idx.end());
+            block.distances.insert(block.distances.end(), dist.begin(), dist.end());
+        }
+    });
+
+    offsets.clear();
+    indices.clear();
+    distances.clear();
+    offsets.reserve(pnts.size() + 1);
+    offsets.push_back(0);
+    for (const auto& block : blocks) {
+        for (std::size_t count : block.counts) {
+            offsets.push_back(offsets.back() + count);
+        }
+        indices.insert(indices.end(), block.indices.begin(), block.indices.end());
+        distances.insert(distances.end(), block.distances.begin(), block.distances.end());
+    }
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef POINTS_OCTREE_H
+#define POINTS_OCTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Points.h"
+
+#define POINTS_CT_OCTREE_LEAF 1024  // Default value for the maximum number of points per leaf
+
+
+namespace Points
+{
+
+/**
+ * The PointsOctree sorts the points of a cloud along a Morton (Z-order) curve and organizes them
+ * in an octree whose nodes are contiguous ranges of the sorted index list. Thus every node is a
+ * compact chunk of spatially close points.
+ *
+ * It is used to select the points of a region without iterating the whole cloud, to get an
+ * evenly distributed subset of a huge cloud for display and to search the neighbours of many
+ * points in parallel. Points with NaN coordinates are not part of the octree. All coordinates are
+ * in the local system of the point kernel, i.e. the placement is not applied.
+ */
+class PointsExport PointsOctree
+{
+public:
+    /** @name Construction */
+    //@{
+    /// Construction
+    explicit PointsOctree(const PointKernel& kernel,
+                          unsigned long leafSize = POINTS_CT_OCTREE_LEAF);
+    //@}
+
+    /** Rebuilds the octree for the attached point kernel. */
+    void Rebuild(unsigned long leafSize = POINTS_CT_OCTREE_LEAF);
+    /** Returns the indices of all valid points sorted along the Morton curve. */
+    const std::vector<unsigned long>& GetIndices() const
+    {
+        return _indices;
+    }
+    /** Returns the bounding box of all valid points. */
+    const Base::BoundBox3d& GetBoundBox() const
+    {
+        return _box;
+    }
+    /** Adds the indices of all points inside the box \a box to \a indices. */
+    void Inside(const Base::BoundBox3d& box, std::vector<unsigned long>& indices) const;
+    /** Returns at most \a maxPoints indices of points that are evenly distributed over the whole
+     * cloud. If the cloud has fewer valid points all of them are returned.
+     */
+    std::vector<unsigned long> GetLevelOfDetail(std::size_t maxPoints) const;
+
+    /** @name Neighbour search */
+    //@{
+    /** Searches the \a k nearest points of \a pnt and stores their indices and distances sorted by
+     * increasing distance. If the cloud has fewer valid points all of them are returned.
+     */
+    void NearestNeighbours(const Base::Vector3f& pnt,
+                           unsigned long k,
+                           std::vector<unsigned long>& indices,
+                           std::vector<float>& distances) const;
+    /** Searches all points with a distance of at most \a radius to \a pnt and stores their indices
+     * and distances sorted by increasing distance.
+     */
+    void Within(const Base::Vector3f& pnt,
+                float radius,
+                std::vector<unsigned long>& indices,
+                std::vector<float>& distances) const;
+    /** Searches the \a k nearest points of each point of \a pnts in parallel. The neighbours of
+     * the i-th point are at position i * k of \a indices and \a distances. \a k is reduced to the
+     * number of valid points if needed.
+     * @return the number of neighbours per point
+     */
+    unsigned long NearestNeighbours(const std::vector<Base::Vector3f>& pnts,
+                                    unsigned long k,
+                                    std::vector<unsigned long>& indices,
+                                    std::vector<float>& distances) const;
+    /** Searches the points within \a radius of each point of \a pnts in parallel. The neighbours
+     * of the i-th point are in the range [offsets[i], offsets[i + 1]) of \a indices and
+     * \a distances.
+     */
+    void Within(const std::vector<Base::Vector3f>& pnts,
+                float radius,
+                std::vector<std::size_t>& offsets,
+                std::vector<unsigned long>& indices,
+                std::vector<float>& distances) const;
+    //@}
+
+private:
+    struct Node
+    {
+        Base::BoundBox3d box;
+        unsigned long begin {0};
+        unsigned long end {0};
+        unsigned long child {0};
+        unsigned long numChildren {0};
+    };
+
+    Base::BoundBox3d Split(unsigned long node, int depth, const std::vector<std::uint64_t>& codes);
+
+private:
+    const PointKernel* _kernel;
+    unsigned long _leafSize;
+    Base::BoundBox3d _box;
+    std::vector<unsigned long> _indices;
+    std::vector<Node> _nodes;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_OCTREE_H
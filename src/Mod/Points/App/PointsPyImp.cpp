@@ -25,12 +25,15 @@
 #include <boost/math/special_functions/fpclassify.hpp>
 #endif
 
+#include <Base/BoundBoxPy.h>
 #include <Base/Builder3D.h>
 #include <Base/Converter.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/Interpreter.h>
 #include <Base/VectorPy.h>
 
 #include "Points.h"
+#include "PointsOctree.h"
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
 #include "PointsPy.cpp"
@@ -38,6 +41,60 @@
 
 using namespace Points;
 
+namespace
+{
+// converts a list of vectors or tuples into the local system of the point kernel
+std::vector<Base::Vector3f> getLocalPoints(PyObject* obj, Base::Matrix4D mat)
+{
+    Py::Sequence list(obj);
+    Py::Type vType(Base::getTypeAsObject(&Base::VectorPy::Type));
+    mat.inverseGauss();
+
+    std::vector<Base::Vector3f> pnts;
+    pnts.reserve(list.size());
+    for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+        Base::Vector3d pnt;
+        if ((*it).isType(vType)) {
+            pnt = Py::Vector(*it).toVector();
+        }
+        else {
+            Py::Tuple tuple(*it);
+            pnt.x = (double)Py::Float(tuple[0]);
+            pnt.y = (double)Py::Float(tuple[1]);
+            pnt.z = (double)Py::Float(tuple[2]);
+        }
+        pnts.push_back(Base::convertTo<Base::Vector3f>(mat * pnt));
+    }
+
+    return pnts;
+}
+
+// returns a tuple with a list of index tuples and a list of distance tuples
+Py::Tuple getNeighbourLists(const std::vector<std::size_t>& offsets,
+                            const std::vector<unsigned long>& indices,
+                            const std::vector<float>& distances)
+{
+    Py::List indexList;
+    Py::List distanceList;
+    for (std::size_t i = 0; i + 1 < offsets.size(); i++) {
+        Py::Tuple idx(static_cast<Py::sequence_index_type>(offsets[i + 1] - offsets[i]));
+        Py::Tuple dist(static_cast<Py::sequence_index_type>(offsets[i + 1] - offsets[i]));
+        for (std::size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+            auto pos = static_cast<Py::sequence_index_type>(j - offsets[i]);
+            idx.setItem(pos, Py::Long(indices[j]));
+            dist.setItem(pos, Py::Float(distances[j]));
+        }
+        indexList.append(idx);
+        distanceList.append(dist);
+    }
+
+    Py::Tuple tuple(2);
+    tuple.setItem(0, indexList);
+    tuple.setItem(1, distanceList);
+    return tuple;
+}
+}  // namespace
+
 // returns a string which represents the object e.g. when printed in python
 std::string PointsPy::representation() const
 {
@@ -217,6 +274,100 @@ PyObject* PointsPy::fromSegment(PyObject* args)
     }
 }
 
+PyObject* PointsPy::getPointsInBox(PyObject* args)
+{
+    PyObject* obj {};
+    if (!PyArg_ParseTuple(args, "O!", &Base::BoundBoxPy::Type, &obj)) {
+        return nullptr;
+    }
+
+    const PointKernel* points = getPointKernelPtr();
+    Base::BoundBox3d box = Py::BoundingBox(obj, false).getValue();
+
+    // A single query has to touch every point anyway, so a plain scan is cheaper than building
+    // an octree first
+    Py::List list;
+    unsigned long index = 0;
+    for (const auto& it : *points) {
+        if (box.IsInBox(it)) {
+            list.append(Py::Long(index));
+        }
+        index++;
+    }
+
+    return Py::new_reference_to(list);
+}
+
+PyObject* PointsPy::nearestNeighbours(PyObject* args)
+{
+    PyObject* obj {};
+    int k {};
+    if (!PyArg_ParseTuple(args, "Oi", &obj, &k)) {
+        return nullptr;
+    }
+    if (k < 1) {
+        PyErr_SetString(PyExc_ValueError, "number of neighbours must be positive");
+        return nullptr;
+    }
+
+    try {
+        const PointKernel* points = getPointKernelPtr();
+        std::vector<Base::Vector3f> pnts = getLocalPoints(obj, points->getTransform());
+        std::vector<std::size_t> offsets;
+        std::vector<unsigned long> indices;
+        std::vector<float> distances;
+        {
+            Base::PyGILStateRelease releaser {};
+            PointsOctree octree(*points);
+            unsigned long num = octree.NearestNeighbours(pnts, k, indices, distances);
+            offsets.reserve(pnts.size() + 1);
+            for (std::size_t i = 0; i <= pnts.size(); i++) {
+                offsets.push_back(i * num);
+            }
+        }
+
+        return Py::new_reference_to(getNeighbourLists(offsets, indices, distances));
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(PyExc_TypeError,
+                        "either expect\n"
+                        "-- [Vector,...] \n"
+                        "-- [(x,y,z),...]");
+        return nullptr;
+    }
+}
+
+PyObject* PointsPy::neighboursWithin(PyObject* args)
+{
+    PyObject* obj {};
+    double radius {};
+    if (!PyArg_ParseTuple(args, "Od", &obj, &radius)) {
+        return nullptr;
+    }
+
+    try {
+        const PointKernel* points = getPointKernelPtr();
+        std::vector<Base::Vector3f> pnts = getLocalPoints(obj, points->getTransform());
+        std::vector<std::size_t> offsets;
+        std::vector<unsigned long> indices;
+        std::vector<float> distances;
+        {
+            Base::PyGILStateRelease releaser {};
+            PointsOctree octree(*points);
+            octree.Within(pnts, static_cast<float>(radius), offsets, indices, distances);
+        }
+
+        return Py::new_reference_to(getNeighbourLists(offsets, indices, distances));
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(PyExc_TypeError,
+                        "either expect\n"
+                        "-- [Vector,...] \n"
+                        "-- [(x,y,z),...]");
+        return nullptr;
+    }
+}
+
 PyObject* PointsPy::fromValid(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -42,17 +42,20 @@
 #include <cmath>
 #include <iostream>
 #include <memory>
+#include <queue>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 // boost
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
-#include <boost/regex.hpp>
 
 // Qt
+#include <QFile>
+#include <QFuture>
 #include <QtConcurrentMap>
 
 #endif  //_PreComp_
@@ -44,6 +44,7 @@
 #include <Gui/Selection/SoFCSelection.h>
 #include <Gui/View3DInventorViewer.h>
 #include <Mod/Points/App/PointsFeature.h>
+#include <Mod/Points/App/PointsOctree.h>
 #include <Mod/Points/App/Properties.h>
 
 #include "ViewProvider.h"
@@ -114,13 +115,14 @@ void ViewProviderPoints::onChanged(const App::Property* prop)
 void ViewProviderPoints::setVertexColorMode(App::PropertyColorList* pcProperty)
 {
     const std::vector<App::Color>& val = pcProperty->getValues();
+    std::size_t num = lodIndices.empty() ? val.size() : lodIndices.size();
 
-    pcColorMat->diffuseColor.setNum(val.size());
+    pcColorMat->diffuseColor.setNum(num);
     SbColor* col = pcColorMat->diffuseColor.startEditing();
 
-    std::size_t i = 0;
-    for (const auto& it : val) {
-        col[i++].setValue(it.r, it.g, it.b);
+    for (std::size_t i = 0; i < num; i++) {
+        const App::Color& it = val[lodIndices.empty() ? i : lodIndices[i]];
+        col[i].setValue(it.r, it.g, it.b);
     }
 
     pcColorMat->diffuseColor.finishEditing();
@@ -129,13 +131,14 @@ void ViewProviderPoints::setVertexColorMode(App::PropertyColorList* pcProperty)
 void ViewProviderPoints::setVertexGreyvalueMode(Points::PropertyGreyValueList* pcProperty)
 {
     const std::vector<float>& val = pcProperty->getValues();
+    std::size_t num = lodIndices.empty() ? val.size() : lodIndices.size();
 
-    pcColorMat->diffuseColor.setNum(val.size());
+    pcColorMat->diffuseColor.setNum(num);
     SbColor* col = pcColorMat->diffuseColor.startEditing();
 
-    std::size_t i = 0;
-    for (float it : val) {
-        col[i++].setValue(it, it, it);
+    for (std::size_t i = 0; i < num; i++) {
+        float it = val[lodIndices.empty() ? i : lodIndices[i]];
+        col[i].setValue(it, it, it);
     }
 
     pcColorMat->diffuseColor.finishEditing();
@@ -144,21 +147,32 @@ void ViewProviderPoints::setVertexGreyvalueMode(Points::PropertyGreyValueList* p
 void ViewProviderPoints::setVertexNormalMode(Points::PropertyNormalList* pcProperty)
 {
     const std::vector<Base::Vector3f>& val = pcProperty->getValues();
+    std::size_t num = lodIndices.empty() ? val.size() : lodIndices.size();
 
-    pcPointsNormal->vector.setNum(val.size());
+    pcPointsNormal->vector.setNum(num);
     SbVec3f* norm = pcPointsNormal->vector.startEditing();
 
-    std::size_t i = 0;
-    for (const auto& it : val) {
-        norm[i++].setValue(it.x, it.y, it.z);
+    for (std::size_t i = 0; i < num; i++) {
+        const Base::Vector3f& it = val[lodIndices.empty() ? i : lodIndices[i]];
+        norm[i].setValue(it.x, it.y, it.z);
     }
 
     pcPointsNormal->vector.finishEditing();
 }
 
+int ViewProviderPoints::countPoints() const
+{
+    if (lodIndices.empty()) {
+        return pcPointsCoord->point.getNum();
+    }
+
+    Points::Feature* fea = static_cast<Points::Feature*>(pcObject);
+    return static_cast<int>(fea->Points.getValue().size());
+}
+
 void ViewProviderPoints::setDisplayMode(const char* ModeName)
 {
-    int numPoints = pcPointsCoord->point.getNum();
+    int numPoints = countPoints();
 
     if (strcmp("Color", ModeName) == 0) {
         std::map<std::string, App::Property*> Map;
@@ -366,8 +380,22 @@ void ViewProviderPoints::clipPointsCallback(void*, SoEventCallback* n)
 
 PROPERTY_SOURCE(PointsGui::ViewProviderScattered, PointsGui::ViewProviderPoints)
 
+App::PropertyIntegerConstraint::Constraints ViewProviderScattered::intRange = {
+    0,
+    std::numeric_limits<int>::max(),
+    100000};
+
 ViewProviderScattered::ViewProviderScattered()
 {
+    static const char* osgroup = "Object Style";
+
+    ADD_PROPERTY_TYPE(MaximumPoints,
+                      (5000000),
+                      osgroup,
+                      App::Prop_None,
+                      "Maximum number of displayed points, 0 shows all points");
+    MaximumPoints.setConstraints(&intRange);
+
     pcPoints = new SoPointSet();
     pcPoints->ref();
 }
@@ -423,12 +451,39 @@ void ViewProviderScattered::attach(App::DocumentObject* pcObj)
     }
 }
 
+void ViewProviderScattered::onChanged(const App::Property* prop)
+{
+    if (prop == &MaximumPoints) {
+        if (pcObject) {
+            updateData(&static_cast<Points::Feature*>(pcObject)->Points);
+        }
+    }
+    else {
+        ViewProviderPoints::onChanged(prop);
+    }
+}
+
 void ViewProviderScattered::updateData(const App::Property* prop)
 {
     ViewProviderPoints::updateData(prop);
     if (prop->is<Points::PropertyPointKernel>()) {
+        // For huge clouds only display an evenly distributed subset of the points
+        const Points::PointKernel& kernel =
+            static_cast<const Points::PropertyPointKernel*>(prop)->getValue();
+        auto maxPoints = static_cast<std::size_t>(MaximumPoints.getValue());
+        lodIndices.clear();
+        if (maxPoints > 0 && kernel.size() > maxPoints) {
+            Points::PointsOctree octree(kernel);
+            lodIndices = octree.GetLevelOfDetail(maxPoints);
+        }
+
         ViewProviderPointsBuilder builder;
-        builder.createPoints(prop, pcPointsCoord, pcPoints);
+        if (lodIndices.empty()) {
+            builder.createPoints(prop, pcPointsCoord, pcPoints);
+        }
+        else {
+            builder.createPoints(prop, pcPointsCoord, pcPoints, lodIndices);
+        }
 
         // The number of points might have changed, so force also a resize of the Inventor internals
         setActiveMode();
@@ -725,6 +780,30 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
     coords->point.finishEditing();
 }
 
+void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
+                                             SoCoordinate3* coords,
+                                             SoPointSet* points,
+                                             const std::vector<unsigned long>& indices) const
+{
+    const Points::PropertyPointKernel* prop_points =
+        static_cast<const Points::PropertyPointKernel*>(prop);
+    const Points::PointKernel& cPts = prop_points->getValue();
+
+    coords->point.setNum(indices.size());
+    SbVec3f* vec = coords->point.startEditing();
+
+    // get the given points only
+    std::size_t idx = 0;
+    const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
+    for (unsigned long index : indices) {
+        const Points::PointKernel::value_type& it = kernel[index];
+        vec[idx++].setValue(it.x, it.y, it.z);
+    }
+
+    points->numPoints = indices.size();
+    coords->point.finishEditing();
+}
+
 void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
                                              SoCoordinate3* coords,
                                              SoIndexedPointSet* points) const
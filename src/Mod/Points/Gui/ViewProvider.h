@@ -67,6 +67,10 @@ public:
     ~ViewProviderPointsBuilder() override = default;
     void buildNodes(const App::Property*, std::vector<SoNode*>&) const override;
     void createPoints(const App::Property*, SoCoordinate3*, SoPointSet*) const;
+    void createPoints(const App::Property*,
+                      SoCoordinate3*,
+                      SoPointSet*,
+                      const std::vector<unsigned long>& indices) const;
     void createPoints(const App::Property*, SoCoordinate3*, SoIndexedPointSet*) const;
 };
 
@@ -104,6 +108,8 @@ protected:
     void setVertexColorMode(App::PropertyColorList*);
     void setVertexGreyvalueMode(Points::PropertyGreyValueList*);
     void setVertexNormalMode(Points::PropertyNormalList*);
+    /// Returns the number of points of the cloud, including the ones that are not displayed
+    int countPoints() const;
     virtual void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer& Viewer) = 0;
 
 protected:
@@ -112,6 +118,8 @@ protected:
     SoMaterial* pcColorMat;
     SoNormal* pcPointsNormal;
     SoDrawStyle* pcPointStyle;
+    /// Indices of the displayed points if only a level of detail is shown, otherwise empty
+    std::vector<unsigned long> lodIndices;
 
 private:
     static App::PropertyFloatConstraint::Constraints floatRange;
@@ -130,6 +138,9 @@ public:
     ViewProviderScattered();
     ~ViewProviderScattered() override;
 
+    /// Maximum number of displayed points, 0 means no limit
+    App::PropertyIntegerConstraint MaximumPoints;
+
     /**
      * Extracts the point data from the feature \a pcFeature and creates
      * an Inventor node \a SoNode with these data.
@@ -139,10 +150,14 @@ public:
     void updateData(const App::Property*) override;
 
 protected:
+    void onChanged(const App::Property* prop) override;
     void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer& Viewer) override;
 
 protected:
     SoPointSet* pcPoints;
+
+private:
+    static App::PropertyIntegerConstraint::Constraints intRange;
 };
 
 /**
@@ -22,6 +22,10 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <cmath>
+#include <map>
+#include <string>
+
 #include <Geom_BSplineSurface.hxx>
 #include <TColgp_Array1OfPnt.hxx>
 #endif
@@ -31,6 +35,7 @@
 #include <Base/GeometryPyCXX.h>
 #include <Base/Interpreter.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
+#include <Base/Tools.h>
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/Part/App/BSplineSurfacePy.h>
 #include <Mod/Points/App/PointsPy.h>
@@ -124,10 +129,11 @@ public:
         add_keyword_method("filterVoxelGrid",&Module::filterVoxelGrid,
             "filterVoxelGrid(dim)."
         );
+#endif
         add_keyword_method("normalEstimation",&Module::normalEstimation,
             "normalEstimation(Points,[KSearch=0, SearchRadius=0]) -> Normals\n"
             "KSearch is an int and used to search the k-nearest neighbours in\n"
-            "the k-d tree. Alternatively, SearchRadius (a float) can be used\n"
+            "the octree. Alternatively, SearchRadius (a float) can be used\n"
             "as spatial distance to determine the neighbours of a point\n"
             "Example:\n"
             "\n"
@@ -142,7 +148,6 @@ public:
             "f.ViewObject.Proxy=0\n"
             "f.ViewObject.DisplayMode=1\n"
         );
-#endif
 #if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("regionGrowingSegmentation",&Module::regionGrowingSegmentation,
             "regionGrowingSegmentation()."
@@ -156,6 +161,17 @@ public:
             "sampleConsensus()."
         );
 #endif
+        add_keyword_method("detectPrimitives",&Module::detectPrimitives,
+            "detectPrimitives(Points,[Normals, Types, DistanceThreshold=0.01, MaxAngle=25,\n"
+            "                 MinSupport=100, Hypotheses=64, Seed=0]) -> list\n"
+            "Detects planes, spheres, cylinders and cones in the point cloud.\n"
+            "Types is a list of 'Plane', 'Sphere', 'Cylinder' or 'Cone' and defaults\n"
+            "to all of them. If Normals is not given they are estimated from the ten\n"
+            "nearest neighbours. MaxAngle is the maximum deviation in degree between\n"
+            "the normal of a point and the shape. Each hypothesis is built from\n"
+            "random samples that only depend on Seed, so the result is reproducible.\n"
+            "Every detected shape is a dict with the keys Type, Parameters and Model.\n"
+        );
         initialize("This module is the ReverseEngineering module."); // register with Python
     }
 
@@ -793,7 +809,6 @@ Mesh.show(m)
         return Py::asObject(new Points::PointsPy(points_sample));
     }
 #endif
-#if defined(HAVE_PCL_FILTERS)
     Py::Object normalEstimation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -806,13 +821,19 @@ Mesh.show(m)
                                         &ksearch, &searchRadius))
             throw Py::Exception();
 
+        if (ksearch <= 0 && searchRadius <= 0)
+            throw Py::ValueError("Either KSearch or SearchRadius must be set");
+
         Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
 
         std::vector<Base::Vector3d> normals;
-        NormalEstimation estimate(*points);
-        estimate.setKSearch(ksearch);
-        estimate.setSearchRadius(searchRadius);
-        estimate.perform(normals);
+        {
+            Base::PyGILStateRelease releaser{};
+            NormalEstimation estimate(*points);
+            estimate.setKSearch(ksearch);
+            estimate.setSearchRadius(searchRadius);
+            estimate.perform(normals);
+        }
 
         Py::List list;
         for (std::vector<Base::Vector3d>::iterator it = normals.begin(); it != normals.end(); ++it) {
@@ -821,7 +842,6 @@ Mesh.show(m)
 
         return list;
     }
-#endif
 #if defined(HAVE_PCL_SEGMENTATION)
     Py::Object regionGrowingSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
@@ -975,6 +995,97 @@ Points.show(np)
         return dict;
     }
 #endif
+    Py::Object detectPrimitives(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        PyObject *vec = nullptr;
+        PyObject *typ = nullptr;
+        double distance = 0.01;
+        double angle = 25.0;
+        int minSupport = 100;
+        int hypotheses = 64;
+        unsigned int seed = 0;
+
+        static const std::array<const char*,9> kwds_detect {"Points", "Normals", "Types", "DistanceThreshold",
+                                                           "MaxAngle", "MinSupport", "Hypotheses", "Seed", NULL};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|OOddiiI", kwds_detect,
+                                        &(Points::PointsPy::Type), &pts, &vec, &typ,
+                                        &distance, &angle, &minSupport, &hypotheses, &seed))
+            throw Py::Exception();
+
+        if (distance <= 0 || minSupport < 0 || hypotheses <= 0)
+            throw Py::ValueError("DistanceThreshold and Hypotheses must be positive, MinSupport must not be negative");
+
+        PrimitiveDetection::Parameters params;
+        params.distanceThreshold = distance;
+        params.normalThreshold = std::cos(Base::toRadians(angle));
+        params.minSupport = static_cast<std::size_t>(minSupport);
+        params.hypotheses = hypotheses;
+        params.seed = seed;
+
+        const std::map<std::string, PrimitiveDetection::Type> typeNames = {
+            {"Plane", PrimitiveDetection::Plane},
+            {"Sphere", PrimitiveDetection::Sphere},
+            {"Cylinder", PrimitiveDetection::Cylinder},
+            {"Cone", PrimitiveDetection::Cone},
+        };
+        if (typ && typ != Py_None) {
+            params.types = 0;
+            Py::Sequence list(typ);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                std::string name = Py::String(*it);
+                auto jt = typeNames.find(name);
+                if (jt == typeNames.end())
+                    throw Py::ValueError("Unsupported shape type: " + name);
+                params.types |= jt->second;
+            }
+        }
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+        std::vector<Base::Vector3d> normals;
+        if (vec && vec != Py_None) {
+            Py::Sequence list(vec);
+            normals.reserve(list.size());
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                normals.push_back(Py::Vector(*it).toVector());
+            }
+            if (normals.size() != points->size())
+                throw Py::ValueError("Number of points and normals doesn't match");
+        }
+
+        std::vector<PrimitiveDetection::Primitive> primitives;
+        {
+            Base::PyGILStateRelease releaser{};
+            if (normals.empty()) {
+                NormalEstimation estimate(*points);
+                estimate.setKSearch(10);
+                estimate.perform(normals);
+            }
+
+            PrimitiveDetection detection(*points, normals);
+            primitives = detection.perform(params);
+        }
+
+        Py::List list;
+        for (const auto& it : primitives) {
+            Py::Dict dict;
+            for (const auto& jt : typeNames) {
+                if (jt.second == it.type)
+                    dict.setItem(Py::String("Type"), Py::String(jt.first));
+            }
+            Py::Tuple parameters(it.parameters.size());
+            for (std::size_t i = 0; i < it.parameters.size(); i++)
+                parameters.setItem(i, Py::Float(it.parameters[i]));
+            Py::Tuple model(it.indices.size());
+            for (std::size_t i = 0; i < it.indices.size(); i++)
+                model.setItem(i, Py::Long(it.indices[i]));
+            dict.setItem(Py::String("Parameters"), parameters);
+            dict.setItem(Py::String("Model"), model);
+            list.append(dict);
+        }
+
+        return list;
+    }
 };
 
 PyObject* initModule()
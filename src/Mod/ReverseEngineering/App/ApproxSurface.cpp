@@ -22,8 +22,8 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
-#include <QFuture>
-#include <QFutureWatcher>
+#include <algorithm>
+#include <thread>
 #include <QtConcurrentMap>
 
 #include <Geom_BSplineSurface.hxx>
@@ -40,7 +40,29 @@
 
 
 using namespace Reen;
-namespace sp = std::placeholders;
+
+namespace
+{
+// Splits the index range [lower, upper] into at most 'numBlocks' blocks of at
+// least 'minBlockSize' indices each
+std::vector<std::pair<int, int>> splitRange(int lower, int upper, int numBlocks, int minBlockSize)
+{
+    int numIndices = upper - lower + 1;
+    numBlocks = std::max(1, std::min(numBlocks, numIndices / minBlockSize));
+    int blockSize = (numIndices + numBlocks - 1) / numBlocks;
+
+    std::vector<std::pair<int, int>> blocks;
+    for (int i = lower; i <= upper; i += blockSize) {
+        blocks.emplace_back(i, std::min(i + blockSize - 1, upper));
+    }
+    return blocks;
+}
+
+int numberOfThreads()
+{
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+}  // namespace
 
 // SplineBasisfunction
 
@@ -966,6 +988,22 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 
     Base::SequencerLauncher seq("Calc surface...", iIter * _pvcPoints->Length());
 
+    // The points are corrected independently of each other, so each block only
+    // keeps track of its own maximum values
+    struct Correction
+    {
+        int begin;
+        int end;
+        double fMaxDiff;
+        double fMaxScalar;
+    };
+
+    std::vector<Correction> blocks;
+    for (const auto& it :
+         splitRange(_pvcPoints->Lower(), _pvcPoints->Upper(), 4 * numberOfThreads(), 256)) {
+        blocks.push_back({it.first, it.second, 0.0, 1.0});
+    }
+
     do {
         fMaxScalar = 1.0;
         fMaxDiff = 0.0;
@@ -978,51 +1016,62 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
                                                                              _usUOrder - 1,
                                                                              _usVOrder - 1);
 
-        for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-            double fDeltaU, fDeltaV, fU, fV;
-            const gp_Pnt& pnt = (*_pvcPoints)(ii);
-            gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
-            gp_Pnt PntX;
-            gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
-            // Calculate the first two derivatives and point at (u,v)
-            gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
-            pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
-            gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
-            gp_Vec ErrorVec = X - P;
-
-            // Calculate Xu x Xv the normal in X(u,v)
-            gp_Dir clNormal = Xu ^ Xv;
-
-            // Check, if X = P
-            if (!(X.IsEqual(P, 0.001, 0.001))) {
-                ErrorVec.Normalize();
-                if (fabs(clNormal * ErrorVec) < fMaxScalar) {
-                    fMaxScalar = fabs(clNormal * ErrorVec);
+        auto correct = [this, &pclBSplineSurf](Correction& block) {
+            block.fMaxScalar = 1.0;
+            block.fMaxDiff = 0.0;
+            for (int ii = block.begin; ii <= block.end; ii++) {
+                double fDeltaU, fDeltaV, fU, fV;
+                const gp_Pnt& pnt = (*_pvcPoints)(ii);
+                gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
+                gp_Pnt PntX;
+                gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
+                // Calculate the first two derivatives and point at (u,v)
+                gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+                pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
+                gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
+                gp_Vec ErrorVec = X - P;
+
+                // Calculate Xu x Xv the normal in X(u,v)
+                gp_Dir clNormal = Xu ^ Xv;
+
+                // Check, if X = P
+                if (!(X.IsEqual(P, 0.001, 0.001))) {
+                    ErrorVec.Normalize();
+                    if (fabs(clNormal * ErrorVec) < block.fMaxScalar) {
+                        block.fMaxScalar = fabs(clNormal * ErrorVec);
+                    }
                 }
-            }
 
-            fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
-            if (fabs(fDeltaU) < Precision::Confusion()) {
-                fDeltaU = 0.0;
-            }
-            fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
-            if (fabs(fDeltaV) < Precision::Confusion()) {
-                fDeltaV = 0.0;
-            }
+                fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
+                if (fabs(fDeltaU) < Precision::Confusion()) {
+                    fDeltaU = 0.0;
+                }
+                fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
+                if (fabs(fDeltaV) < Precision::Confusion()) {
+                    fDeltaV = 0.0;
+                }
 
-            // Replace old u/v values with new ones
-            fU = uvValue.X() - fDeltaU;
-            fV = uvValue.Y() - fDeltaV;
-            if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
-                uvValue.SetX(fU);
-                uvValue.SetY(fV);
-                fMaxDiff = std::max<double>(fabs(fDeltaU), fMaxDiff);
-                fMaxDiff = std::max<double>(fabs(fDeltaV), fMaxDiff);
+                // Replace old u/v values with new ones
+                fU = uvValue.X() - fDeltaU;
+                fV = uvValue.Y() - fDeltaV;
+                if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
+                    uvValue.SetX(fU);
+                    uvValue.SetY(fV);
+                    block.fMaxDiff = std::max<double>(fabs(fDeltaU), block.fMaxDiff);
+                    block.fMaxDiff = std::max<double>(fabs(fDeltaV), block.fMaxDiff);
+                }
             }
+        };
+
+        QtConcurrent::blockingMap(blocks, correct);
 
-            seq.next();
+        for (const auto& it : blocks) {
+            fMaxScalar = std::min<double>(it.fMaxScalar, fMaxScalar);
+            fMaxDiff = std::max<double>(it.fMaxDiff, fMaxDiff);
         }
 
+        seq.setProgress(static_cast<size_t>(i + 1) * _pvcPoints->Length());
+
         if (_bSmoothing) {
             fWeight *= 0.5f;
             SolveWithSmoothing(fWeight);
@@ -1035,11 +1084,120 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
     } while (i < iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
 }
 
+void BSplineParameterCorrection::EvaluateBasisFunctions(double fU,
+                                                        double fV,
+                                                        std::vector<int>& indices,
+                                                        std::vector<double>& values)
+{
+    // Due to the local support only order(u) * order(v) basis functions don't vanish
+    fU = std::clamp(fU, 0.0, 1.0);
+    fV = std::clamp(fV, 0.0, 1.0);
+
+    int iUOrder = static_cast<int>(_usUOrder);
+    int iVOrder = static_cast<int>(_usVOrder);
+    TColStd_Array1OfReal basisU(0, iUOrder - 1);
+    TColStd_Array1OfReal basisV(0, iVOrder - 1);
+    _clUSpline.AllBasisFunctions(fU, basisU);
+    _clVSpline.AllBasisFunctions(fV, basisV);
+    int iFirstU = _clUSpline.FindSpan(fU) - iUOrder + 1;
+    int iFirstV = _clVSpline.FindSpan(fV) - iVOrder + 1;
+
+    indices.clear();
+    values.clear();
+    for (int j = 0; j < iUOrder; j++) {
+        for (int k = 0; k < iVOrder; k++) {
+            indices.push_back((iFirstU + j) * static_cast<int>(_usVCtrlpoints) + iFirstV + k);
+            values.push_back(basisU(j) * basisV(k));
+        }
+    }
+}
+
+void BSplineParameterCorrection::AssembleNormalEquations(math_Matrix& MTM,
+                                                         math_Vector& Mbx,
+                                                         math_Vector& Mby,
+                                                         math_Vector& Mbz)
+{
+    int ulDim = static_cast<int>(_usUCtrlpoints * _usVCtrlpoints);
+
+    // Each thread sums up the contributions of its points into its own partial
+    // matrix. Only the upper triangle is computed because M^T*M is symmetric.
+    struct PartialSystem
+    {
+        int begin;
+        int end;
+        std::vector<double> mtm;
+        std::vector<double> mbx;
+        std::vector<double> mby;
+        std::vector<double> mbz;
+    };
+
+    std::vector<PartialSystem> blocks;
+    for (const auto& it :
+         splitRange(_pvcPoints->Lower(), _pvcPoints->Upper(), numberOfThreads(), 1024)) {
+        blocks.push_back({it.first, it.second, {}, {}, {}, {}});
+    }
+
+    auto assemble = [this, ulDim](PartialSystem& block) {
+        block.mtm.assign(static_cast<std::size_t>(ulDim) * ulDim, 0.0);
+        block.mbx.assign(ulDim, 0.0);
+        block.mby.assign(ulDim, 0.0);
+        block.mbz.assign(ulDim, 0.0);
+
+        std::vector<int> indices;
+        std::vector<double> values;
+        for (int ii = block.begin; ii <= block.end; ii++) {
+            const gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+            const gp_Pnt& pnt = (*_pvcPoints)(ii);
+            EvaluateBasisFunctions(uvValue.X(), uvValue.Y(), indices, values);
+
+            // the indices are in ascending order
+            std::size_t num = indices.size();
+            for (std::size_t m = 0; m < num; m++) {
+                double value = values[m];
+                if (value == 0.0) {
+                    continue;
+                }
+                double* row = &block.mtm[static_cast<std::size_t>(indices[m]) * ulDim];
+                for (std::size_t n = m; n < num; n++) {
+                    row[indices[n]] += value * values[n];
+                }
+                block.mbx[indices[m]] += value * pnt.X();
+                block.mby[indices[m]] += value * pnt.Y();
+                block.mbz[indices[m]] += value * pnt.Z();
+            }
+        }
+    };
+
+    QtConcurrent::blockingMap(blocks, assemble);
+
+    MTM.Init(0.0);
+    Mbx.Init(0.0);
+    Mby.Init(0.0);
+    Mbz.Init(0.0);
+    for (const auto& it : blocks) {
+        for (int m = 0; m < ulDim; m++) {
+            const double* row = &it.mtm[static_cast<std::size_t>(m) * ulDim];
+            for (int n = m; n < ulDim; n++) {
+                MTM(m, n) += row[n];
+            }
+            Mbx(m) += it.mbx[m];
+            Mby(m) += it.mby[m];
+            Mbz(m) += it.mbz[m];
+        }
+    }
+
+    for (int m = 0; m < ulDim; m++) {
+        for (int n = 0; n < m; n++) {
+            MTM(m, n) = MTM(n, m);
+        }
+    }
+}
+
 bool BSplineParameterCorrection::SolveWithoutSmoothing()
 {
     unsigned ulSize = _pvcPoints->Length();
     unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
+    math_Matrix M(0, ulSize - 1, 0, ulDim - 1, 0.0);
     math_Matrix Xx(0, ulDim - 1, 0, 0);
     math_Matrix Xy(0, ulDim - 1, 0, 0);
     math_Matrix Xz(0, ulDim - 1, 0, 0);
@@ -1047,39 +1205,23 @@ bool BSplineParameterCorrection::SolveWithoutSmoothing()
     math_Vector by(0, ulSize - 1);
     math_Vector bz(0, ulSize - 1);
 
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx = 0;
-
-        // Pre-calculation of the values of the base functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
-
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
+    // Determining the coefficient matrix of the overdetermined LGS.
+    // Every row is written by one thread only.
+    auto fillRows = [this, &M](const std::pair<int, int>& block) {
+        std::vector<int> indices;
+        std::vector<double> values;
+        for (int i = block.first; i <= block.second; i++) {
+            const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
+            EvaluateBasisFunctions(uvValue.X(), uvValue.Y(), indices, values);
+            for (std::size_t j = 0; j < indices.size(); j++) {
+                M(i, indices[j]) = values[j];
             }
         }
-    }
+    };
+
+    std::vector<std::pair<int, int>> blocks =
+        splitRange(0, static_cast<int>(ulSize) - 1, 4 * numberOfThreads(), 1024);
+    QtConcurrent::blockingMap(blocks, fillRows);
 
     // Determine the right side
     for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
@@ -1113,147 +1255,31 @@ bool BSplineParameterCorrection::SolveWithoutSmoothing()
     return true;
 }
 
-namespace Reen
-{
-class ScalarProduct
-{
-public:
-    explicit ScalarProduct(const math_Matrix& mat)
-        : mat(mat)
-    {}
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n = mat.LowerCol(); n <= mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
-        }
-        return out;
-    }
-
-private:
-    const math_Matrix& mat;
-};
-}  // namespace Reen
-
 bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
 {
-    unsigned ulSize = _pvcPoints->Length();
     unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
+    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
     math_Vector Xx(0, ulDim - 1);
     math_Vector Xy(0, ulDim - 1);
     math_Vector Xz(0, ulDim - 1);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
     math_Vector Mbx(0, ulDim - 1);
     math_Vector Mby(0, ulDim - 1);
     math_Vector Mbz(0, ulDim - 1);
 
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx = 0;
-
-        // Pre-calculation of the values of the basis functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
-
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
-            }
-        }
-    }
-
-    // The product of its transform and itself results in the quadratic
-    // system matrix (slowly)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    for (unsigned m = 0; m < ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n = m; n < ulDim; n++) {
-            MTM(m, n) = MTM(n, m) = Mm * M.Col(n);
-        }
-    }
-#else  // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    // NOLINTBEGIN
-    QFuture<std::vector<double>> future =
-        QtConcurrent::mapped(columns, std::bind(&ScalarProduct::multiply, &scalar, sp::_1));
-    // NOLINTEND
-    QFutureWatcher<std::vector<double>> watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
+    // The quadratic system matrix M^T*M and the right sides M^T*b are directly
+    // built up without setting up the overdetermined LGS
+    AssembleNormalEquations(MTM, Mbx, Mby, Mbz);
 
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    int rowIndex = 0;
-    for (const auto& it : future) {
-        int colIndex = 0;
-        for (std::vector<double>::const_iterator jt = it.begin(); jt != it.end();
-             ++jt, colIndex++) {
-            MTM(rowIndex, colIndex) = *jt;
-        }
-        rowIndex++;
-    }
-#endif
-
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-    for (unsigned i = 0; i < ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
-    }
-
-    // Solve the LGS with the LU decomposition
-    math_Gauss mgGaussX(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussY(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM + fWeight * _clSmoothMatrix);
-
-    mgGaussX.Solve(Mbx, Xx);
-    if (!mgGaussX.IsDone()) {
-        return false;
-    }
-
-    mgGaussY.Solve(Mby, Xy);
-    if (!mgGaussY.IsDone()) {
+    // Solve the LGS with the LU decomposition. The system matrix is the same for
+    // all three coordinates, so it's decomposed only once.
+    math_Gauss mgGauss(MTM + fWeight * _clSmoothMatrix);
+    if (!mgGauss.IsDone()) {
         return false;
     }
 
-    mgGaussZ.Solve(Mbz, Xz);
-    if (!mgGaussZ.IsDone()) {
-        return false;
-    }
+    mgGauss.Solve(Mbx, Xx);
+    mgGauss.Solve(Mby, Xy);
+    mgGauss.Solve(Mbz, Xz);
 
     unsigned ulIdx = 0;
     for (unsigned j = 0; j < _usUCtrlpoints; j++) {
@@ -23,6 +23,8 @@
 #ifndef REEN_APPROXSURFACE_H
 #define REEN_APPROXSURFACE_H
 
+#include <vector>
+
 #include <Geom_BSplineSurface.hxx>
 #include <TColStd_Array1OfInteger.hxx>
 #include <TColStd_Array1OfReal.hxx>
@@ -30,6 +32,7 @@
 #include <TColgp_Array1OfPnt2d.hxx>
 #include <TColgp_Array2OfPnt.hxx>
 #include <math_Matrix.hxx>
+#include <math_Vector.hxx>
 
 #include <Base/Vector3D.h>
 #include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
@@ -414,6 +417,24 @@ protected:
      */
     bool SolveWithSmoothing(double fWeight) override;
 
+    /**
+     * Calculates the products of the u- and v-basis functions that don't vanish at (fU, fV)
+     * together with the indices of their control points in ascending order
+     */
+    void EvaluateBasisFunctions(double fU,
+                                double fV,
+                                std::vector<int>& indices,
+                                std::vector<double>& values);
+
+    /**
+     * Sets up the normal equations M^T*M and M^T*b of the overdetermined LGS. The points
+     * are distributed over several threads that sum up partial matrices.
+     */
+    void AssembleNormalEquations(math_Matrix& MTM,
+                                 math_Vector& Mbx,
+                                 math_Vector& Mby,
+                                 math_Vector& Mbz);
+
 public:
     /**
      * Setting the knot vector
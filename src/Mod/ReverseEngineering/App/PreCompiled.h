@@ -41,7 +41,14 @@
 #ifdef _PreComp_
 
 // standard
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <random>
+#include <thread>
+#include <vector>
 
 // boost
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -0,0 +1,133 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+# ***************************************************************************
+# *                                                                         *
+# *   This file is part of FreeCAD.                                         *
+# *                                                                         *
+# *   FreeCAD is free software: you can redistribute it and/or modify it    *
+# *   under the terms of the GNU Lesser General Public License as           *
+# *   published by the Free Software Foundation, either version 2.1 of the  *
+# *   License, or (at your option) any later version.                       *
+# *                                                                         *
+# *   FreeCAD is distributed in the hope that it will be useful, but        *
+# *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+# *   Lesser General Public License for more details.                       *
+# *                                                                         *
+# *   You should have received a copy of the GNU Lesser General Public      *
+# *   License along with FreeCAD. If not, see                               *
+# *   <https://www.gnu.org/licenses/>.                                      *
+# *                                                                         *
+# ***************************************************************************
+
+import math
+import unittest
+import FreeCAD
+import Points
+import ReverseEngineering
+
+
+class PrimitiveDetectionCases(unittest.TestCase):
+    def setUp(self):
+        # Noise-free samples of four shapes that are far enough apart not to share any points.
+        # Each shape gets a contiguous range of indices.
+        points = []
+        normals = []
+
+        # 900 points on the plane z = -3
+        for i in range(30):
+            for j in range(30):
+                points.append(FreeCAD.Vector(0.1 * i, 0.1 * j, -3.0))
+                normals.append(FreeCAD.Vector(0, 0, 1))
+
+        # 600 points on the sphere around (10, 0, 0) with radius 1
+        count = 600
+        golden = math.pi * (3.0 - math.sqrt(5.0))
+        for i in range(count):
+            z = 1.0 - (2.0 * i + 1.0) / count
+            r = math.sqrt(1.0 - z * z)
+            normal = FreeCAD.Vector(r * math.cos(i * golden), r * math.sin(i * golden), z)
+            points.append(FreeCAD.Vector(10, 0, 0) + normal)
+            normals.append(normal)
+
+        # 800 points on the cylinder around the z-axis through (0, 10, 0) with radius 0.8
+        for h in range(20):
+            for a in range(40):
+                t = 2.0 * math.pi * a / 40
+                normal = FreeCAD.Vector(math.cos(t), math.sin(t), 0)
+                points.append(FreeCAD.Vector(0, 10, 0.1 * h) + normal * 0.8)
+                normals.append(normal)
+
+        # 720 points on the cone with apex (10, 10, 3), axis (0, 0, -1) and an opening angle
+        # of 30 degree
+        angle = math.radians(30)
+        for h in range(20):
+            for a in range(36):
+                t = 2.0 * math.pi * a / 36
+                height = 0.3 + 0.1 * h
+                radial = FreeCAD.Vector(math.cos(t), math.sin(t), 0)
+                axis = FreeCAD.Vector(0, 0, -1)
+                apex = FreeCAD.Vector(10, 10, 3)
+                points.append(apex + axis * height + radial * (height * math.tan(angle)))
+                normals.append(radial * math.cos(angle) - axis * math.sin(angle))
+
+        self.points = Points.Points(points)
+        self.normals = normals
+        self.ranges = {
+            "Plane": range(0, 900),
+            "Sphere": range(900, 1500),
+            "Cylinder": range(1500, 2300),
+            "Cone": range(2300, 3020),
+        }
+
+    def detect(self, seed):
+        return ReverseEngineering.detectPrimitives(self.points, Normals=self.normals, Seed=seed)
+
+    def assertVector(self, values, vector):
+        self.assertAlmostEqual(values[0], vector[0], places=3)
+        self.assertAlmostEqual(values[1], vector[1], places=3)
+        self.assertAlmostEqual(values[2], vector[2], places=3)
+
+    def testDetection(self):
+        shapes = {}
+        for shape in self.detect(0):
+            self.assertNotIn(shape["Type"], shapes)
+            shapes[shape["Type"]] = shape
+        self.assertEqual(sorted(shapes.keys()), sorted(self.ranges.keys()))
+
+        for name, indices in self.ranges.items():
+            model = shapes[name]["Model"]
+            self.assertEqual(len(model), len(indices))
+            self.assertEqual(sorted(model), list(indices))
+
+        # normal and distance to the origin, the orientation of the normal is arbitrary
+        plane = shapes["Plane"]["Parameters"]
+        self.assertEqual(len(plane), 4)
+        self.assertAlmostEqual(abs(plane[2]), 1.0, places=4)
+        self.assertAlmostEqual(plane[3] / plane[2], 3.0, places=4)
+
+        # center and radius
+        sphere = shapes["Sphere"]["Parameters"]
+        self.assertEqual(len(sphere), 4)
+        self.assertVector(sphere[0:3], (10, 0, 0))
+        self.assertAlmostEqual(sphere[3], 1.0, places=4)
+
+        # point on the axis, direction of the axis and radius
+        cylinder = shapes["Cylinder"]["Parameters"]
+        self.assertEqual(len(cylinder), 7)
+        self.assertAlmostEqual(cylinder[0], 0.0, places=4)
+        self.assertAlmostEqual(cylinder[1], 10.0, places=4)
+        self.assertAlmostEqual(abs(cylinder[5]), 1.0, places=4)
+        self.assertAlmostEqual(cylinder[6], 0.8, places=4)
+
+        # apex, direction of the axis towards the points and opening angle
+        cone = shapes["Cone"]["Parameters"]
+        self.assertEqual(len(cone), 7)
+        self.assertVector(cone[0:3], (10, 10, 3))
+        self.assertVector(cone[3:6], (0, 0, -1))
+        self.assertAlmostEqual(cone[6], math.radians(30), places=4)
+
+    def testSeed(self):
+        first = self.detect(7)
+        second = self.detect(7)
+        self.assertEqual(len(first), 4)
+        self.assertEqual(first, second)
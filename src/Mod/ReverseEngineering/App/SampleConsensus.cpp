@@ -22,11 +22,23 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <random>
+
 #include <boost/math/special_functions/fpclassify.hpp>
+
+#include <QtConcurrentMap>
 #endif
 
+#include <Eigen/Eigenvalues>
+#include <Eigen/LU>
+
 #include <Base/Exception.h>
 #include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsOctree.h>
 
 #include "SampleConsensus.h"
 
@@ -39,9 +51,12 @@
 #include <pcl/sample_consensus/sac_model_cylinder.h>
 #include <pcl/sample_consensus/sac_model_plane.h>
 #include <pcl/sample_consensus/sac_model_sphere.h>
+#endif
 
 using namespace std;
 using namespace Reen;
+
+#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
 using pcl::PointCloud;
 using pcl::PointNormal;
 using pcl::PointXYZ;
@@ -141,3 +156,465 @@ double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>
 }
 
 #endif  // HAVE_PCL_SAMPLE_CONSENSUS
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+struct Shape
+{
+    PrimitiveDetection::Type type {PrimitiveDetection::Plane};
+    Base::Vector3d base;  // point on the plane or axis, center of the sphere, apex of the cone
+    Base::Vector3d axis;  // normal of the plane or direction of the axis
+    double value {0.0};   // radius or opening angle of the cone
+};
+
+bool isValid(const Base::Vector3d& v)
+{
+    return !std::isnan(v.x) && !std::isnan(v.y) && !std::isnan(v.z);
+}
+
+// Computes the distance of a point to the shape and the shape normal at the closest point
+double distanceToShape(const Shape& shape, const Base::Vector3d& pnt, Base::Vector3d& normal)
+{
+    Base::Vector3d dir = pnt - shape.base;
+    switch (shape.type) {
+        case PrimitiveDetection::Plane: {
+            normal = shape.axis;
+            return std::fabs(dir * shape.axis);
+        }
+        case PrimitiveDetection::Sphere: {
+            double len = dir.Length();
+            normal = len > 0.0 ? dir / len : shape.axis;
+            return std::fabs(len - shape.value);
+        }
+        case PrimitiveDetection::Cylinder: {
+            Base::Vector3d radial = dir - shape.axis * (dir * shape.axis);
+            double len = radial.Length();
+            normal = len > 0.0 ? radial / len : shape.axis;
+            return std::fabs(len - shape.value);
+        }
+        case PrimitiveDetection::Cone: {
+            double along = dir * shape.axis;
+            Base::Vector3d radial = dir - shape.axis * along;
+            double len = radial.Length();
+            double sina = std::sin(shape.value);
+            double cosa = std::cos(shape.value);
+            // the apex is the closest point
+            if (along * cosa + len * sina < 0.0) {
+                normal = shape.axis;
+                return dir.Length();
+            }
+            if (len > 0.0) {
+                radial /= len;
+            }
+            normal = radial * cosa - shape.axis * sina;
+            return std::fabs(len * cosa - along * sina);
+        }
+    }
+
+    return std::numeric_limits<double>::max();
+}
+
+bool isInlier(const Shape& shape,
+              const Base::Vector3d& pnt,
+              const Base::Vector3d& nor,
+              const PrimitiveDetection::Parameters& params)
+{
+    Base::Vector3d normal;
+    double dist = distanceToShape(shape, pnt, normal);
+    return dist <= params.distanceThreshold && std::fabs(normal * nor) >= params.normalThreshold;
+}
+
+// Computes the closest points of the lines p0 + t * n0 and p1 + s * n1 with unit directions
+bool closestPoints(const Base::Vector3d& p0,
+                   const Base::Vector3d& n0,
+                   const Base::Vector3d& p1,
+                   const Base::Vector3d& n1,
+                   Base::Vector3d& c0,
+                   Base::Vector3d& c1)
+{
+    Base::Vector3d w = p0 - p1;
+    double b = n0 * n1;
+    double d = n0 * w;
+    double e = n1 * w;
+    double denom = 1.0 - b * b;
+    if (denom < 1.0e-6) {
+        return false;
+    }
+
+    c0 = p0 + n0 * ((b * e - d) / denom);
+    c1 = p1 + n1 * ((e - b * d) / denom);
+    return true;
+}
+
+// Builds a shape of the given type from three points with unit normals
+bool fitShape(PrimitiveDetection::Type type,
+              const Base::Vector3d* pnts,
+              const Base::Vector3d* nors,
+              const PrimitiveDetection::Parameters& params,
+              Shape& shape)
+{
+    shape.type = type;
+    switch (type) {
+        case PrimitiveDetection::Plane: {
+            shape.base = pnts[0];
+            shape.axis = (pnts[1] - pnts[0]) % (pnts[2] - pnts[0]);
+            if (shape.axis.Length() < 1.0e-12) {
+                return false;
+            }
+            shape.axis.Normalize();
+            break;
+        }
+        case PrimitiveDetection::Sphere: {
+            Base::Vector3d c0, c1;
+            if (!closestPoints(pnts[0], nors[0], pnts[1], nors[1], c0, c1)) {
+                return false;
+            }
+            shape.base = (c0 + c1) / 2.0;
+            shape.axis = nors[0];
+            shape.value =
+                (Base::Distance(pnts[0], shape.base) + Base::Distance(pnts[1], shape.base)) / 2.0;
+            break;
+        }
+        case PrimitiveDetection::Cylinder: {
+            shape.axis = nors[0] % nors[1];
+            if (shape.axis.Length() < 1.0e-3) {
+                return false;
+            }
+            shape.axis.Normalize();
+            Base::Vector3d c0, c1;
+            if (!closestPoints(pnts[0], nors[0], pnts[1], nors[1], c0, c1)) {
+                return false;
+            }
+            shape.base = c0;
+            shape.value = 0.0;
+            for (int i = 0; i < 2; i++) {
+                Base::Vector3d dir = pnts[i] - shape.base;
+                shape.value += (dir - shape.axis * (dir * shape.axis)).Length() / 2.0;
+            }
+            break;
+        }
+        case PrimitiveDetection::Cone: {
+            // the apex is the intersection of the three tangent planes
+            Eigen::Matrix3d mat;
+            Eigen::Vector3d rhs;
+            for (int i = 0; i < 3; i++) {
+                mat.row(i) << nors[i].x, nors[i].y, nors[i].z;
+                rhs(i) = nors[i] * pnts[i];
+            }
+            Eigen::FullPivLU<Eigen::Matrix3d> lu(mat);
+            if (!lu.isInvertible()) {
+                return false;
+            }
+            Eigen::Vector3d apex = lu.solve(rhs);
+            shape.base.Set(apex.x(), apex.y(), apex.z());
+
+            // the directions from the apex to the points lie on a circle around the axis
+            Base::Vector3d dirs[3];
+            for (int i = 0; i < 3; i++) {
+                dirs[i] = pnts[i] - shape.base;
+                if (dirs[i].Length() < 1.0e-12) {
+                    return false;
+                }
+                dirs[i].Normalize();
+            }
+            shape.axis = (dirs[1] - dirs[0]) % (dirs[2] - dirs[0]);
+            if (shape.axis.Length() < 1.0e-12) {
+                return false;
+            }
+            shape.axis.Normalize();
+            if (shape.axis * dirs[0] < 0.0) {
+                shape.axis = -shape.axis;
+            }
+            shape.value = 0.0;
+            for (const auto& dir : dirs) {
+                shape.value += std::acos(std::clamp(shape.axis * dir, -1.0, 1.0)) / 3.0;
+            }
+            // nearly flat or nearly cylindrical cones are better described by other shapes
+            const double minAngle = 0.02;
+            if (shape.value < minAngle || shape.value > M_PI / 2.0 - minAngle) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        if (!isInlier(shape, pnts[i], nors[i], params)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Fits the plane through the inliers by least squares
+void refinePlane(Shape& shape,
+                 const std::vector<int>& inliers,
+                 const std::vector<Base::Vector3d>& points)
+{
+    Eigen::Vector3d center = Eigen::Vector3d::Zero();
+    for (int index : inliers) {
+        center += Eigen::Vector3d(points[index].x, points[index].y, points[index].z);
+    }
+    center /= static_cast<double>(inliers.size());
+
+    Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+    for (int index : inliers) {
+        Eigen::Vector3d diff(points[index].x, points[index].y, points[index].z);
+        diff -= center;
+        covariance += diff * diff.transpose();
+    }
+
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+    Eigen::Vector3d normal = solver.eigenvectors().col(0);
+    shape.base.Set(center.x(), center.y(), center.z());
+    shape.axis.Set(normal.x(), normal.y(), normal.z());
+}
+
+std::vector<float> shapeParameters(const Shape& shape)
+{
+    std::vector<float> parameters;
+    auto add = [&parameters](const Base::Vector3d& v) {
+        parameters.push_back(static_cast<float>(v.x));
+        parameters.push_back(static_cast<float>(v.y));
+        parameters.push_back(static_cast<float>(v.z));
+    };
+
+    if (shape.type == PrimitiveDetection::Plane) {
+        add(shape.axis);
+        parameters.push_back(static_cast<float>(-(shape.axis * shape.base)));
+    }
+    else if (shape.type == PrimitiveDetection::Sphere) {
+        add(shape.base);
+        parameters.push_back(static_cast<float>(shape.value));
+    }
+    else {
+        add(shape.base);
+        add(shape.axis);
+        parameters.push_back(static_cast<float>(shape.value));
+    }
+
+    return parameters;
+}
+}  // namespace
+
+PrimitiveDetection::PrimitiveDetection(const Points::PointKernel& pts,
+                                       const std::vector<Base::Vector3d>& nor)
+    : myPoints(pts)
+    , myNormals(nor)
+{}
+
+std::vector<PrimitiveDetection::Primitive>
+PrimitiveDetection::perform(const Parameters& params) const
+{
+    const std::vector<Points::PointKernel::value_type>& basic = myPoints.getBasicPoints();
+    if (myNormals.size() != basic.size()) {
+        throw Base::ValueError("Number of points and normals doesn't match");
+    }
+
+    // Points without a valid normal are not considered
+    std::vector<Base::Vector3d> points(basic.size());
+    std::vector<Base::Vector3d> normals(basic.size());
+    std::vector<bool> assigned(basic.size(), true);
+    std::vector<int> remaining;
+    for (std::size_t i = 0; i < basic.size(); i++) {
+        points[i] = myPoints.getPoint(static_cast<int>(i));
+        normals[i] = myNormals[i];
+        double len = normals[i].Length();
+        if (isValid(points[i]) && isValid(normals[i]) && len > 0.0) {
+            normals[i] /= len;
+            assigned[i] = false;
+            remaining.push_back(static_cast<int>(i));
+        }
+    }
+
+    std::vector<Type> types;
+    for (Type type : {Plane, Sphere, Cylinder, Cone}) {
+        if (params.types & type) {
+            types.push_back(type);
+        }
+    }
+
+    std::vector<Primitive> primitives;
+    if (types.empty()) {
+        return primitives;
+    }
+
+    // The octree works in the local system of the kernel which doesn't matter for the
+    // neighbourhood of a point
+    Points::PointsOctree octree(myPoints);
+    std::size_t minSupport = std::max<std::size_t>(params.minSupport, 3);
+
+    struct Hypothesis
+    {
+        unsigned int index;
+        Shape shape;
+        std::size_t score;
+    };
+    std::vector<Hypothesis> hypotheses(std::max(params.hypotheses, 1));
+
+    struct Block
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::vector<int> inliers;
+    };
+
+    unsigned int round = 0;
+    int failures = 0;
+    while (remaining.size() >= minSupport && failures < params.maxFailures) {
+        // The hypotheses are scored with a random subset of the remaining points
+        std::vector<int> subset;
+        if (remaining.size() <= params.scoreSamples) {
+            subset = remaining;
+        }
+        else {
+            std::seed_seq seq {params.seed, round};
+            std::mt19937 gen(seq);
+            std::sample(remaining.begin(),
+                        remaining.end(),
+                        std::back_inserter(subset),
+                        params.scoreSamples,
+                        gen);
+        }
+
+        // Each hypothesis has its own random generator so that the samples don't depend on the
+        // order in which the threads process them
+        auto build = [&](Hypothesis& hyp) {
+            hyp.score = 0;
+            std::seed_seq seq {params.seed, round, hyp.index};
+            std::mt19937 gen(seq);
+            std::uniform_int_distribution<std::size_t> pickFirst(0, remaining.size() - 1);
+            int first = remaining[pickFirst(gen)];
+
+            std::vector<unsigned long> indices;
+            std::vector<float> distances;
+            octree.NearestNeighbours(basic[first], params.neighbours, indices, distances);
+            std::vector<int> candidates;
+            for (unsigned long index : indices) {
+                if (static_cast<int>(index) != first && !assigned[index]) {
+                    candidates.push_back(static_cast<int>(index));
+                }
+            }
+            if (candidates.size() < 2) {
+                return;
+            }
+
+            std::uniform_int_distribution<std::size_t> pickOther(0, candidates.size() - 1);
+            std::size_t second = pickOther(gen);
+            std::size_t third = pickOther(gen);
+            if (second == third) {
+                third = (third + 1) % candidates.size();
+            }
+
+            Base::Vector3d pnts[3] = {points[first],
+                                      points[candidates[second]],
+                                      points[candidates[third]]};
+            Base::Vector3d nors[3] = {normals[first],
+                                      normals[candidates[second]],
+                                      normals[candidates[third]]};
+            for (Type type : types) {
+                Shape shape;
+                if (!fitShape(type, pnts, nors, params, shape)) {
+                    continue;
+                }
+                std::size_t score = 0;
+                for (int index : subset) {
+                    if (isInlier(shape, points[index], normals[index], params)) {
+                        score++;
+                    }
+                }
+                if (score > hyp.score) {
+                    hyp.score = score;
+                    hyp.shape = shape;
+                }
+            }
+        };
+
+        for (std::size_t i = 0; i < hypotheses.size(); i++) {
+            hypotheses[i].index = static_cast<unsigned int>(i);
+        }
+        QtConcurrent::blockingMap(hypotheses, build);
+        round++;
+
+        const Hypothesis* best = nullptr;
+        for (const auto& it : hypotheses) {
+            if (it.score > 0 && (!best || it.score > best->score)) {
+                best = &it;
+            }
+        }
+        if (!best) {
+            failures++;
+            continue;
+        }
+
+        // Collect the inliers of the best candidate among all remaining points
+        Shape shape = best->shape;
+        auto collect = [&](Block& block) {
+            block.inliers.clear();
+            for (std::size_t i = block.begin; i < block.end; i++) {
+                int index = remaining[i];
+                if (isInlier(shape, points[index], normals[index], params)) {
+                    block.inliers.push_back(index);
+                }
+            }
+        };
+
+        const std::size_t blockSize = 4096;
+        std::vector<Block> blocks;
+        for (std::size_t i = 0; i < remaining.size(); i += blockSize) {
+            blocks.push_back({i, std::min(i + blockSize, remaining.size()), {}});
+        }
+        QtConcurrent::blockingMap(blocks, collect);
+
+        std::vector<int> inliers;
+        for (const auto& it : blocks) {
+            inliers.insert(inliers.end(), it.inliers.begin(), it.inliers.end());
+        }
+
+        // A plane from three noisy points is slightly tilted, so fit it to all of its inliers
+        if (shape.type == Plane && inliers.size() >= minSupport) {
+            Shape guess = shape;
+            refinePlane(shape, inliers, points);
+            QtConcurrent::blockingMap(blocks, collect);
+            std::size_t count = 0;
+            for (const auto& it : blocks) {
+                count += it.inliers.size();
+            }
+            if (count >= inliers.size()) {
+                inliers.clear();
+                for (const auto& it : blocks) {
+                    inliers.insert(inliers.end(), it.inliers.begin(), it.inliers.end());
+                }
+            }
+            else {
+                shape = guess;
+            }
+        }
+
+        Primitive primitive;
+        primitive.type = shape.type;
+        primitive.parameters = shapeParameters(shape);
+        primitive.indices = std::move(inliers);
+        if (primitive.indices.size() < minSupport) {
+            failures++;
+            continue;
+        }
+
+        for (int index : primitive.indices) {
+            assigned[index] = true;
+        }
+        remaining.erase(std::remove_if(remaining.begin(),
+                                       remaining.end(),
+                                       [&assigned](int index) {
+                                           return assigned[index];
+                                       }),
+                        remaining.end());
+        primitives.push_back(std::move(primitive));
+        failures = 0;
+    }
+
+    return primitives;
+}
@@ -59,6 +59,63 @@ private:
     const std::vector<Base::Vector3d>& myNormals;
 };
 
+/**
+ * Detects planes, spheres, cylinders and cones in a point cloud with normals without depending
+ * on PCL. In every round a number of hypotheses is built concurrently from samples of spatially
+ * close points and the candidate with the largest support is extracted. This is repeated until
+ * no further shape with enough support can be found.
+ * All random numbers are derived from the seed, hence the result doesn't depend on the number of
+ * threads.
+ */
+class PrimitiveDetection
+{
+public:
+    enum Type
+    {
+        Plane = 1,
+        Sphere = 2,
+        Cylinder = 4,
+        Cone = 8,
+    };
+
+    struct Parameters
+    {
+        /// Combination of the shape types to search for
+        int types {Plane | Sphere | Cylinder | Cone};
+        /// Maximum distance of an inlier to the shape
+        double distanceThreshold {0.01};
+        /// Minimum cosine of the angle between the point normal and the shape normal
+        double normalThreshold {0.9};
+        /// Minimum number of inliers of a shape
+        std::size_t minSupport {100};
+        /// Number of hypotheses that are built per round
+        int hypotheses {64};
+        /// Number of failed rounds after which the detection stops
+        int maxFailures {3};
+        /// Size of the neighbourhood the samples of a hypothesis are taken from
+        unsigned long neighbours {50};
+        /// Maximum number of points a hypothesis is scored with
+        std::size_t scoreSamples {20000};
+        unsigned int seed {0};
+    };
+
+    struct Primitive
+    {
+        Type type;
+        /// Plane: normal, distance; Sphere: center, radius;
+        /// Cylinder: point on axis, axis, radius; Cone: apex, axis, opening angle
+        std::vector<float> parameters;
+        std::vector<int> indices;
+    };
+
+    PrimitiveDetection(const Points::PointKernel&, const std::vector<Base::Vector3d>&);
+    std::vector<Primitive> perform(const Parameters&) const;
+
+private:
+    const Points::PointKernel& myPoints;
+    const std::vector<Base::Vector3d>& myNormals;
+};
+
 }  // namespace Reen
 
 #endif  // REEN_SAMPLECONSENSUS_H
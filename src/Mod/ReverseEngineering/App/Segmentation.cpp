@@ -21,8 +21,18 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QtConcurrentMap>
+#endif
+
+#include <Eigen/Eigenvalues>
 
 #include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsOctree.h>
 
 #include "Segmentation.h"
 
@@ -160,7 +170,6 @@ void Segmentation::perform(int ksearch)
 
 // ----------------------------------------------------------------------------
 
-#if defined(HAVE_PCL_FILTERS)
 NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
     : myPoints(pts)
     , kSearch(0)
@@ -169,47 +178,64 @@ NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
 
 void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
 {
-    // Copy the points
-    pcl::PointCloud<PointXYZ>::Ptr cloud(new pcl::PointCloud<PointXYZ>);
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
-    }
-
-    cloud->width = int(cloud->points.size());
-    cloud->height = 1;
-
-#if 0
-    // Build a passthrough filter to remove spurious NaNs
-    pcl::PointCloud<PointXYZ>::Ptr cloud_filtered (new pcl::PointCloud<PointXYZ>);
-    pcl::PassThrough<PointXYZ> pass;
-    pass.setInputCloud (cloud);
-    pass.setFilterFieldName ("z");
-    pass.setFilterLimits (0, 1.5);
-    pass.filter (*cloud_filtered);
-#endif
-
-    // Estimate point normals
-    pcl::PointCloud<pcl::Normal>::Ptr cloud_normals(new pcl::PointCloud<pcl::Normal>);
-    pcl::search::KdTree<PointXYZ>::Ptr tree(new pcl::search::KdTree<PointXYZ>());
-    pcl::NormalEstimation<PointXYZ, pcl::Normal> ne;
-    ne.setSearchMethod(tree);
-    // ne.setInputCloud (cloud_filtered);
-    ne.setInputCloud(cloud);
-    if (kSearch > 0) {
-        ne.setKSearch(kSearch);
-    }
-    if (searchRadius > 0) {
-        ne.setRadiusSearch(searchRadius);
-    }
-    ne.compute(*cloud_normals);
-
-    normals.reserve(cloud_normals->size());
-    for (pcl::PointCloud<pcl::Normal>::const_iterator it = cloud_normals->begin();
-         it != cloud_normals->end();
-         ++it) {
-        normals.push_back(Base::Vector3d(it->normal_x, it->normal_y, it->normal_z));
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<Points::PointKernel::value_type>& points = myPoints.getBasicPoints();
+    normals.assign(points.size(), Base::Vector3d(nan, nan, nan));
+
+    Points::PointsOctree octree(myPoints);
+
+    // The normal of a point is the direction of least variance of its neighbourhood, oriented
+    // towards the origin. Points with fewer than three neighbours get an invalid normal.
+    auto estimate = [this, &octree, &points, &normals](std::pair<std::size_t, std::size_t> block) {
+        std::vector<unsigned long> indices;
+        std::vector<float> distances;
+        for (std::size_t i = block.first; i < block.second; i++) {
+            const Base::Vector3f& pnt = points[i];
+            if (std::isnan(pnt.x) || std::isnan(pnt.y) || std::isnan(pnt.z)) {
+                continue;
+            }
+
+            if (kSearch > 0) {
+                octree.NearestNeighbours(pnt, kSearch, indices, distances);
+            }
+            else {
+                octree.Within(pnt, static_cast<float>(searchRadius), indices, distances);
+            }
+            if (indices.size() < 3) {
+                continue;
+            }
+
+            Eigen::Vector3d center = Eigen::Vector3d::Zero();
+            for (unsigned long index : indices) {
+                Base::Vector3d neighbour = myPoints.getPoint(static_cast<int>(index));
+                center += Eigen::Vector3d(neighbour.x, neighbour.y, neighbour.z);
+            }
+            center /= static_cast<double>(indices.size());
+
+            Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+            for (unsigned long index : indices) {
+                Base::Vector3d neighbour = myPoints.getPoint(static_cast<int>(index));
+                Eigen::Vector3d diff(neighbour.x - center.x(),
+                                     neighbour.y - center.y(),
+                                     neighbour.z - center.z());
+                covariance += diff * diff.transpose();
+            }
+
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+            Eigen::Vector3d normal = solver.eigenvectors().col(0);
+            Base::Vector3d pos = myPoints.getPoint(static_cast<int>(i));
+            Base::Vector3d dir(normal.x(), normal.y(), normal.z());
+            if (dir * pos > 0.0) {
+                dir = -dir;
+            }
+            normals[i] = dir;
+        }
+    };
+
+    const std::size_t blockSize = 4096;
+    std::vector<std::pair<std::size_t, std::size_t>> blocks;
+    for (std::size_t i = 0; i < points.size(); i += blockSize) {
+        blocks.emplace_back(i, std::min(i + blockSize, points.size()));
     }
+    QtConcurrent::blockingMap(blocks, estimate);
 }
-
-#endif  // HAVE_PCL_FILTERS
@@ -22,3 +22,7 @@
 # *                                                                         *
 # ***************************************************************************/
 # FreeCAD init script of the ReverseEngineering module
+
+import FreeCAD
+
+FreeCAD.__unit_test__ += ["ReverseEngineeringTestsApp"]
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Curvature.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class CurvatureTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A wavy grid of 20000 facets, with few threads it is computed in several chunks
+        const int size = 100;
+        auto point = [](int i, int j) {
+            float x = 0.1F * float(i);
+            float y = 0.1F * float(j);
+            return Base::Vector3f(x, y, std::sin(x) * std::cos(y));
+        };
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        for (int j = 0; j < size; j++) {
+            for (int i = 0; i < size; i++) {
+                facets.emplace_back(point(i, j), point(i + 1, j), point(i + 1, j + 1));
+                facets.emplace_back(point(i, j), point(i + 1, j + 1), point(i, j + 1));
+            }
+        }
+        kernel = facets;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(CurvatureTest, testParallelMatchesSerial)
+{
+    MeshCore::MeshCurvature serial(kernel);
+    serial.SetRadius(0.25F);
+    serial.ComputePerFace(false);
+
+    MeshCore::MeshCurvature parallel(kernel);
+    parallel.SetRadius(0.25F);
+    parallel.ComputePerFace(true);
+
+    const std::vector<MeshCore::CurvatureInfo>& info1 = serial.GetCurvature();
+    const std::vector<MeshCore::CurvatureInfo>& info2 = parallel.GetCurvature();
+    ASSERT_EQ(info1.size(), kernel.CountFacets());
+    ASSERT_EQ(info2.size(), kernel.CountFacets());
+    for (std::size_t i = 0; i < info1.size(); i++) {
+        ASSERT_EQ(info1[i].fMaxCurvature, info2[i].fMaxCurvature);
+        ASSERT_EQ(info1[i].fMinCurvature, info2[i].fMinCurvature);
+        ASSERT_EQ(info1[i].cMaxCurvDir, info2[i].cMaxCurvDir);
+        ASSERT_EQ(info1[i].cMinCurvDir, info2[i].cMinCurvDir);
+    }
+}
+
+TEST_F(CurvatureTest, testSegment)
+{
+    // the facets of a segment get their curvature in the order of the segment
+    std::vector<MeshCore::FacetIndex> segment {kernel.CountFacets() - 1, 0, 10100};
+    MeshCore::MeshCurvature curvature(kernel, segment);
+    curvature.SetRadius(0.25F);
+    curvature.ComputePerFace(true);
+
+    MeshCore::MeshCurvature all(kernel);
+    all.SetRadius(0.25F);
+    all.ComputePerFace(false);
+
+    ASSERT_EQ(curvature.GetCurvature().size(), segment.size());
+    for (std::size_t i = 0; i < segment.size(); i++) {
+        EXPECT_EQ(curvature.GetCurvature()[i].fMaxCurvature,
+                  all.GetCurvature()[segment[i]].fMaxCurvature);
+        EXPECT_EQ(curvature.GetCurvature()[i].fMinCurvature,
+                  all.GetCurvature()[segment[i]].fMinCurvature);
+    }
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
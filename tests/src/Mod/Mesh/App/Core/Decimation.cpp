@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <list>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class DecimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // wavy grid that is large enough to be split into several slabs
+        const int countX = 400;
+        const int countY = 300;
+        MeshCore::MeshPointArray points;
+        for (int j = 0; j <= countY; j++) {
+            for (int i = 0; i <= countX; i++) {
+                float x = 0.1F * float(i);
+                float y = 0.1F * float(j);
+                points.push_back(Base::Vector3f(x, y, std::sin(x) * std::cos(y)));
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int j = 0; j < countY; j++) {
+            for (int i = 0; i < countX; i++) {
+                MeshCore::PointIndex p1 = j * (countX + 1) + i;
+                MeshCore::PointIndex p2 = p1 + 1;
+                MeshCore::PointIndex p3 = p2 + countX + 1;
+                MeshCore::PointIndex p4 = p1 + countX + 1;
+                facets.push_back(MeshCore::MeshFacet(p1, p2, p3));
+                facets.push_back(MeshCore::MeshFacet(p1, p3, p4));
+            }
+        }
+
+        kernel.Adopt(points, facets, true);
+    }
+
+    static std::size_t countBorders(const MeshCore::MeshKernel& mesh)
+    {
+        std::list<std::vector<MeshCore::PointIndex>> borders;
+        MeshCore::MeshAlgorithm(mesh).GetMeshBorders(borders);
+        return borders.size();
+    }
+
+    static long eulerCharacteristic(const MeshCore::MeshKernel& mesh)
+    {
+        return long(mesh.CountPoints()) - long(mesh.CountEdges()) + long(mesh.CountFacets());
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(DecimationTest, testParallelMatchesSerial)
+{
+    const int targetSize = 20000;
+
+    MeshCore::MeshKernel serial(kernel);
+    MeshCore::MeshSimplify(serial).simplify(targetSize);
+
+    MeshCore::MeshKernel parallel(kernel);
+    MeshCore::MeshSimplify(parallel).simplifyParallel(targetSize);
+
+    // both reach the target size within a few percent
+    EXPECT_LE(parallel.CountFacets(), std::size_t(targetSize * 1.05));
+    EXPECT_GE(parallel.CountFacets(), std::size_t(targetSize * 0.95));
+    EXPECT_NEAR(double(parallel.CountFacets()), double(serial.CountFacets()), 0.05 * targetSize);
+
+    // the slabs are stitched to a single manifold disc like the serial result
+    EXPECT_TRUE(MeshCore::MeshEvalTopology(parallel).Evaluate());
+    EXPECT_TRUE(MeshCore::MeshEvalTopology(serial).Evaluate());
+    EXPECT_EQ(countBorders(parallel), countBorders(serial));
+    EXPECT_EQ(eulerCharacteristic(parallel), eulerCharacteristic(serial));
+    EXPECT_EQ(eulerCharacteristic(parallel), 1);
+}
+
+TEST_F(DecimationTest, testParallelIsReproducible)
+{
+    MeshCore::MeshKernel mesh1(kernel);
+    MeshCore::MeshSimplify(mesh1).simplifyParallel(20000);
+
+    MeshCore::MeshKernel mesh2(kernel);
+    MeshCore::MeshSimplify(mesh2).simplifyParallel(20000);
+
+    ASSERT_EQ(mesh1.CountPoints(), mesh2.CountPoints());
+    ASSERT_EQ(mesh1.CountFacets(), mesh2.CountFacets());
+    for (MeshCore::PointIndex i = 0; i < mesh1.CountPoints(); i++) {
+        EXPECT_EQ(mesh1.GetPoint(i), mesh2.GetPoint(i));
+    }
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <cmath>
+#include <Mod/Mesh/App/Core/FacetBVH.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class FacetBVHTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a finely tessellated patch next to a large coarse plane
+        const int num = 20;
+        const float step = 1.0F / num;
+        for (int i = 0; i < num; i++) {
+            for (int j = 0; j < num; j++) {
+                Base::Vector3f p1(i * step, j * step, 0.0F);
+                Base::Vector3f p2((i + 1) * step, j * step, 0.0F);
+                Base::Vector3f p3(i * step, (j + 1) * step, 0.0F);
+                Base::Vector3f p4((i + 1) * step, (j + 1) * step, 0.0F);
+                kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+                kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+            }
+        }
+
+        Base::Vector3f p1(2.0F, 0.0F, 1.0F);
+        Base::Vector3f p2(100.0F, 0.0F, 1.0F);
+        Base::Vector3f p3(2.0F, 100.0F, 1.0F);
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+    }
+
+    void TearDown() override
+    {}
+
+    float NearestDistance(const Base::Vector3f& pnt) const
+    {
+        float minDist = FLT_MAX;
+        MeshCore::MeshFacetIterator it(kernel);
+        for (it.Init(); it.More(); it.Next()) {
+            minDist = std::min(minDist, it->DistanceToPoint(pnt));
+        }
+        return minDist;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(FacetBVHTest, TestEmpty)
+{
+    MeshCore::MeshKernel empty;
+    MeshCore::MeshFacetBVH tree(empty);
+    EXPECT_EQ(tree.SearchNearestFromPoint(Base::Vector3f()), MeshCore::FACET_INDEX_MAX);
+}
+
+TEST_F(FacetBVHTest, TestNearest)
+{
+    MeshCore::MeshFacetBVH tree(kernel);
+    std::vector<Base::Vector3f> points;
+    points.emplace_back(0.52F, 0.31F, 0.1F);
+    points.emplace_back(-1.0F, -1.0F, 0.0F);
+    points.emplace_back(50.0F, 20.0F, 3.0F);
+    points.emplace_back(1.5F, 0.5F, 0.6F);
+    points.emplace_back(200.0F, 200.0F, -5.0F);
+    for (const auto& pnt : points) {
+        float dist {};
+        MeshCore::FacetIndex index = tree.SearchNearestFromPoint(pnt, FLT_MAX, dist);
+        ASSERT_NE(index, MeshCore::FACET_INDEX_MAX);
+        EXPECT_FLOAT_EQ(dist, NearestDistance(pnt));
+        EXPECT_FLOAT_EQ(kernel.GetFacet(index).DistanceToPoint(pnt), dist);
+    }
+}
+
+TEST_F(FacetBVHTest, TestNearestMaxDist)
+{
+    MeshCore::MeshFacetBVH tree(kernel);
+    float dist {};
+    EXPECT_EQ(tree.SearchNearestFromPoint(Base::Vector3f(0.5F, 0.5F, 2.0F), 0.5F, dist),
+              MeshCore::FACET_INDEX_MAX);
+    EXPECT_NE(tree.SearchNearestFromPoint(Base::Vector3f(0.5F, 0.5F, 0.2F), 0.5F, dist),
+              MeshCore::FACET_INDEX_MAX);
+}
+
+TEST_F(FacetBVHTest, TestTransformed)
+{
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3f(0.0F, 0.0F, 10.0F));
+    MeshCore::MeshFacetBVH tree(kernel, mat);
+    float dist {};
+    tree.SearchNearestFromPoint(Base::Vector3f(0.5F, 0.5F, 10.0F), FLT_MAX, dist);
+    EXPECT_FLOAT_EQ(dist, 0.0F);
+}
+
+TEST_F(FacetBVHTest, TestNearestPoints)
+{
+    MeshCore::MeshFacetBVH tree(kernel);
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < 64; i++) {
+        for (int j = 0; j < 32; j++) {
+            points.emplace_back(-1.0F + i * 0.05F, -1.0F + j * 0.1F, (i % 5) * 0.3F - 0.6F);
+        }
+    }
+
+    std::vector<MeshCore::MeshNearestPoint> result = tree.NearestPoints(points);
+    ASSERT_EQ(result.size(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        ASSERT_NE(result[i].facet, MeshCore::FACET_INDEX_MAX);
+        EXPECT_NEAR(result[i].distance, NearestDistance(points[i]), 1e-5F);
+        float sum = result[i].weights[0] + result[i].weights[1] + result[i].weights[2];
+        EXPECT_NEAR(sum, 1.0F, 1e-3F);
+    }
+}
+
+TEST_F(FacetBVHTest, TestNearestPointSigned)
+{
+    MeshCore::MeshFacetBVH tree(kernel);
+    MeshCore::MeshNearestPoint result;
+    ASSERT_TRUE(tree.NearestPoint(Base::Vector3f(0.5F, 0.5F, -0.25F), FLT_MAX, true, result));
+    EXPECT_FLOAT_EQ(result.distance, -0.25F);
+    EXPECT_FLOAT_EQ(result.point.z, 0.0F);
+    EXPECT_FALSE(tree.NearestPoint(Base::Vector3f(0.5F, 0.5F, -0.25F), 0.1F, true, result));
+}
+
+TEST_F(FacetBVHTest, TestNearestPointSignedAtEdges)
+{
+    // A thin tetrahedron with acute edges. Outside points near its edges and vertices are
+    // often behind the plane of the closest facet.
+    Base::Vector3f corners[4] = {Base::Vector3f(0.0F, 0.0F, 0.0F),
+                                 Base::Vector3f(1.0F, 0.0F, 0.0F),
+                                 Base::Vector3f(0.0F, 1.0F, 0.0F),
+                                 Base::Vector3f(0.1F, 0.1F, 2.0F)};
+    Base::Vector3f center = 0.25F * (corners[0] + corners[1] + corners[2] + corners[3]);
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    const int indices[4][3] = {{0, 2, 1}, {0, 1, 3}, {1, 2, 3}, {0, 3, 2}};
+    for (const auto& it : indices) {
+        MeshCore::MeshGeomFacet facet(corners[it[0]], corners[it[1]], corners[it[2]]);
+        ASSERT_GT((facet._aclPoints[0] - center) * facet.GetNormal(), 0.0F);
+        facets.push_back(facet);
+    }
+
+    MeshCore::MeshKernel tetra;
+    tetra = facets;
+    MeshCore::MeshFacetBVH tree(tetra);
+
+    auto isInside = [&facets](const Base::Vector3f& pnt) {
+        for (const auto& facet : facets) {
+            if ((pnt - facet._aclPoints[0]) * facet.GetNormal() >= 0.0F) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i <= 30; i++) {
+        for (int j = 0; j <= 30; j++) {
+            for (int k = 0; k <= 30; k++) {
+                points.emplace_back(-0.5F + i * 0.07F, -0.5F + j * 0.07F, -0.5F + k * 0.1F);
+            }
+        }
+    }
+
+    std::vector<MeshCore::MeshNearestPoint> result = tree.NearestPoints(points, FLT_MAX, true);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (std::fabs(result[i].distance) < 1e-3F) {
+            continue;
+        }
+        EXPECT_EQ(result[i].distance < 0.0F, isInside(points[i]))
+            << points[i].x << ", " << points[i].y << ", " << points[i].z;
+    }
+}
+
+TEST_F(FacetBVHTest, TestInside)
+{
+    MeshCore::MeshFacetBVH tree(kernel);
+    std::vector<MeshCore::FacetIndex> facets;
+    tree.Inside(Base::BoundBox3f(10.0F, 10.0F, 0.0F, 20.0F, 20.0F, 2.0F), facets);
+    ASSERT_EQ(facets.size(), 1);
+    EXPECT_EQ(facets.front(), kernel.CountFacets() - 1);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
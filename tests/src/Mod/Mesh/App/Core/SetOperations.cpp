@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+namespace
+{
+MeshCore::MeshKernel makeBox(const Base::Vector3f& min, const Base::Vector3f& max)
+{
+    Base::Vector3f pnt[8];
+    for (int i = 0; i < 8; i++) {
+        pnt[i].Set(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z);
+    }
+
+    const int corners[12][3] = {{0, 2, 1},
+                                {1, 2, 3},
+                                {4, 5, 6},
+                                {5, 7, 6},
+                                {0, 1, 4},
+                                {1, 5, 4},
+                                {2, 6, 3},
+                                {3, 6, 7},
+                                {0, 4, 2},
+                                {2, 4, 6},
+                                {1, 3, 5},
+                                {3, 7, 5}};
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    for (const auto& it : corners) {
+        facets.emplace_back(pnt[it[0]], pnt[it[1]], pnt[it[2]]);
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel = facets;
+    return kernel;
+}
+}  // namespace
+
+TEST(SetOperationsTest, testCoplanarOverlapUsesExtremePoints)
+{
+    // A sliver crosses the facet from its bottom edge to its hypotenuse. The edges cross
+    // four times and the first two intersections both lie on the bottom edge.
+    MeshCore::MeshGeomFacet facet1(Base::Vector3f(0, 0, 0),
+                                   Base::Vector3f(4, 0, 0),
+                                   Base::Vector3f(0, 4, 0));
+    MeshCore::MeshGeomFacet facet2(Base::Vector3f(1, -1, 0),
+                                   Base::Vector3f(1, 5, 0),
+                                   Base::Vector3f(1.5F, -1, 0));
+
+    Base::Vector3f pnt0, pnt1;
+    ASSERT_EQ(facet1.IntersectWithCoplanarFacet(facet2, pnt0, pnt1), 2);
+    EXPECT_FLOAT_EQ(std::min(pnt0.y, pnt1.y), 0.0F);
+    EXPECT_FLOAT_EQ(std::max(pnt0.y, pnt1.y), 3.0F);
+    EXPECT_NEAR(Base::Distance(pnt0, pnt1), 3.0288, 1e-4);
+}
+
+TEST(SetOperationsTest, testCoplanarTouchingPoint)
+{
+    MeshCore::MeshGeomFacet facet1(Base::Vector3f(0, 0, 0),
+                                   Base::Vector3f(1, 0, 0),
+                                   Base::Vector3f(0, 1, 0));
+    MeshCore::MeshGeomFacet facet2(Base::Vector3f(1, 0, 0),
+                                   Base::Vector3f(2, 0, 0),
+                                   Base::Vector3f(1, 1, 0));
+
+    Base::Vector3f pnt0, pnt1;
+    EXPECT_EQ(facet1.IntersectWithCoplanarFacet(facet2, pnt0, pnt1), 1);
+    EXPECT_EQ(pnt0, Base::Vector3f(1, 0, 0));
+}
+TEST(SetOperationsTest, testCrossingBoxes)
+{
+    MeshCore::MeshKernel box1 = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        makeBox(Base::Vector3f(0.5F, 0.25F, 0.25F), Base::Vector3f(1.5F, 0.75F, 0.75F));
+
+    MeshCore::MeshKernel result;
+    MeshCore::SetOperations(box1, box2, result, MeshCore::SetOperations::Union).Do();
+    EXPECT_NEAR(result.GetVolume(), 1.125F, 1e-4F);
+
+    MeshCore::SetOperations(box1, box2, result, MeshCore::SetOperations::Intersect).Do();
+    EXPECT_NEAR(result.GetVolume(), 0.125F, 1e-4F);
+
+    MeshCore::SetOperations(box1, box2, result, MeshCore::SetOperations::Difference).Do();
+    EXPECT_NEAR(result.GetVolume(), 0.875F, 1e-4F);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
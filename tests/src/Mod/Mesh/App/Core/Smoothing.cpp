@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // 3x3 grid of points where the center point is lifted
+        for (int j = 0; j < 2; j++) {
+            for (int i = 0; i < 2; i++) {
+                Base::Vector3f p1 = point(i, j);
+                Base::Vector3f p2 = point(i + 1, j);
+                Base::Vector3f p3 = point(i + 1, j + 1);
+                Base::Vector3f p4 = point(i, j + 1);
+                kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+                kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p3, p4));
+            }
+        }
+    }
+
+    static Base::Vector3f point(int i, int j)
+    {
+        float z = (i == 1 && j == 1) ? 1.0F : 0.0F;
+        return Base::Vector3f(float(i), float(j), z);
+    }
+
+    MeshCore::PointIndex center() const
+    {
+        const MeshCore::MeshPointArray& points = kernel.GetPoints();
+        for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+            if (points[i].z > 0.0F) {
+                return i;
+            }
+        }
+        return MeshCore::POINT_INDEX_MAX;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(SmoothingTest, testLaplaceMovesInteriorPoint)
+{
+    MeshCore::PointIndex index = center();
+    ASSERT_NE(index, MeshCore::POINT_INDEX_MAX);
+
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.SetLambda(0.5);
+    smooth.Smooth(1);
+
+    // the border points are fixed so the centroid of the neighbours is on the plane
+    EXPECT_FLOAT_EQ(kernel.GetPoint(index).z, 0.5F);
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        if (i != index) {
+            EXPECT_FLOAT_EQ(kernel.GetPoint(i).z, 0.0F);
+        }
+    }
+}
+
+TEST_F(SmoothingTest, testPinnedPointKeepsPosition)
+{
+    MeshCore::PointIndex index = center();
+    ASSERT_NE(index, MeshCore::POINT_INDEX_MAX);
+
+    MeshCore::TaubinSmoothing smooth(kernel);
+    smooth.SetPinnedPoints({index});
+    smooth.Smooth(4);
+
+    EXPECT_FLOAT_EQ(kernel.GetPoint(index).z, 1.0F);
+}
+
+TEST(UmbrellaOperatorTest, testParallelMatchesSerial)
+{
+    // A wavy grid of 201 x 201 points is large enough to be processed in parallel ranges
+    const int size = 200;
+    auto point = [](int i, int j) {
+        float z = std::sin(0.3F * float(i)) * std::cos(0.2F * float(j));
+        return Base::Vector3f(float(i), float(j), z);
+    };
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    for (int j = 0; j < size; j++) {
+        for (int i = 0; i < size; i++) {
+            facets.emplace_back(point(i, j), point(i + 1, j), point(i + 1, j + 1));
+            facets.emplace_back(point(i, j), point(i + 1, j + 1), point(i, j + 1));
+        }
+    }
+    MeshCore::MeshKernel kernel;
+    kernel = facets;
+    ASSERT_EQ(kernel.CountPoints(), (size + 1) * (size + 1));
+
+    // serial reference: every step moves the inner points at once towards the centroid of
+    // their neighbours, the points on the border are fixed
+    const double stepsize = 0.5;
+    const int iterations = 3;
+    MeshCore::MeshRefPointToPoints nbPoints(kernel);
+    std::vector<Base::Vector3f> expected(kernel.GetPoints().begin(), kernel.GetPoints().end());
+    for (int it = 0; it < iterations; it++) {
+        std::vector<Base::Vector3f> next = expected;
+        for (MeshCore::PointIndex i = 0; i < expected.size(); i++) {
+            const Base::Vector3f& pnt = expected[i];
+            if (pnt.x == 0.0F || pnt.y == 0.0F || pnt.x == float(size) || pnt.y == float(size)) {
+                continue;
+            }
+            double sx = 0.0, sy = 0.0, sz = 0.0;
+            for (MeshCore::PointIndex nb : nbPoints[i]) {
+                sx += expected[nb].x;
+                sy += expected[nb].y;
+                sz += expected[nb].z;
+            }
+            const double w = 1.0 / double(nbPoints[i].size());
+            next[i].Set(float(pnt.x + stepsize * (w * sx - pnt.x)),
+                        float(pnt.y + stepsize * (w * sy - pnt.y)),
+                        float(pnt.z + stepsize * (w * sz - pnt.z)));
+        }
+        expected.swap(next);
+    }
+
+    MeshCore::UmbrellaOperator umbrella(kernel);
+    for (int it = 0; it < iterations; it++) {
+        umbrella.Apply(stepsize);
+    }
+    umbrella.Commit();
+
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        Base::Vector3f pnt = kernel.GetPoint(i);
+        ASSERT_FLOAT_EQ(pnt.x, expected[i].x);
+        ASSERT_FLOAT_EQ(pnt.y, expected[i].y);
+        ASSERT_FLOAT_EQ(pnt.z, expected[i].z);
+    }
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <Base/FileInfo.h>
 #include <Mod/Mesh/App/Core/IO/Reader3MF.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <sstream>
+#include <string>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <zipios++/fcoll.h>
 
@@ -37,4 +41,83 @@ TEST_F(ImporterTest, Test3MF)
     EXPECT_EQ(mesh2.CountEdges(), 1950);
     EXPECT_EQ(mesh2.CountFacets(), 1300);
 }
+
+TEST_F(ImporterTest, TestAsciiSTL)
+{
+    std::stringstream str;
+    str << "solid test\n"
+           "  facet normal 0 0 1\n"
+           "    outer loop\n"
+           "      vertex 0 0 0\n"
+           "      vertex 1.0 0 0\n"
+           "      vertex 0 1e0 0\r\n"
+           "    endloop\n"
+           "  endfacet\n"
+           "  facet  normal 0 0 1\n"
+           "    outer loop\n"
+           "      vertex 1 0 0\n"
+           "      vertex 1 1 0\n"
+           "      vertex 0 1 0\n"
+           "    endloop\n"
+           "  endfacet\n"
+           "endsolid test\n";
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshInput input(mesh);
+    EXPECT_TRUE(input.LoadSTL(str));
+    EXPECT_EQ(mesh.CountPoints(), 4);
+    EXPECT_EQ(mesh.CountEdges(), 5);
+    EXPECT_EQ(mesh.CountFacets(), 2);
+}
+TEST_F(ImporterTest, TestAsciiSTLFromMemory)
+{
+    std::string str;
+    str.append("solid test\n");
+    for (int i = 0; i < 100; i++) {
+        str.append("  facet normal 0 0 1\n"
+                   "    outer loop\n");
+        str.append("      vertex " + std::to_string(i) + " 0 0\n");
+        str.append("      vertex " + std::to_string(i + 1) + " 0 0\n");
+        str.append("      vertex " + std::to_string(i) + " 1 0\r\n");
+        str.append("    endloop\n"
+                   "  endfacet\n");
+    }
+    str.append("endsolid test\n");
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshInput input(mesh);
+    EXPECT_TRUE(input.LoadSTL(str.data(), str.size()));
+    EXPECT_EQ(mesh.CountPoints(), 201);
+    EXPECT_EQ(mesh.CountFacets(), 100);
+
+    MeshCore::MeshKernel streamMesh;
+    MeshCore::MeshInput streamInput(streamMesh);
+    std::stringstream stream(str);
+    EXPECT_TRUE(streamInput.LoadSTL(stream));
+    EXPECT_EQ(mesh.CountPoints(), streamMesh.CountPoints());
+    EXPECT_EQ(mesh.CountEdges(), streamMesh.CountEdges());
+    EXPECT_FLOAT_EQ(mesh.GetSurface(), streamMesh.GetSurface());
+}
+
+TEST_F(ImporterTest, TestBinarySTLFromMemory)
+{
+    const uint32_t numFacets = 10000;
+    std::string str(80, '\0');
+    str.append(reinterpret_cast<const char*>(&numFacets), sizeof(numFacets));
+    for (uint32_t i = 0; i < numFacets; i++) {
+        float record[12] = {0, 0, 1, float(i), 0, 0, float(i + 1), 0, 0, float(i), 1, 0};
+        str.append(reinterpret_cast<const char*>(record), sizeof(record));
+        str.append(2, '\0');
+    }
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshInput input(mesh);
+    EXPECT_TRUE(input.LoadSTL(str.data(), str.size()));
+    EXPECT_EQ(mesh.CountPoints(), 2 * numFacets + 1);
+    EXPECT_EQ(mesh.CountFacets(), numFacets);
+    EXPECT_FLOAT_EQ(mesh.GetSurface(), 0.5F * numFacets);
+
+    // a truncated file must be rejected
+    EXPECT_FALSE(input.LoadBinarySTL(str.data(), str.size() - 1));
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
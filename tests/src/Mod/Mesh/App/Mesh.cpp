@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
+#include <cfloat>
 #include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
 #include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/TopoAlgorithm.h>
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
 TEST(MeshTest, TestDefault)
@@ -95,4 +99,153 @@ TEST(MeshTest, TestGrid2OfAlmostPlanarMesh)
     EXPECT_EQ(countY, 1);
     EXPECT_EQ(countZ, 1);
 }
+
+TEST(MeshTest, TestComponentsKeepFlags)
+{
+    MeshCore::MeshKernel kernel;
+    Base::Vector3f p1 {0, 0, 0};
+    Base::Vector3f p2 {1, 0, 0};
+    Base::Vector3f p3 {0, 1, 0};
+    Base::Vector3f p4 {1, 1, 0};
+    Base::Vector3f offset {0, 0, 5};
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p1 + offset, p2 + offset, p3 + offset));
+
+    std::vector<std::vector<MeshCore::FacetIndex>> segments;
+    MeshCore::MeshComponents comp(kernel);
+    comp.SearchForComponents(MeshCore::MeshComponents::OverEdge, segments);
+    ASSERT_EQ(segments.size(), 2);
+    EXPECT_EQ(segments[0].size(), 2);
+    EXPECT_EQ(segments[1].size(), 1);
+    for (const auto& facet : kernel.GetFacets()) {
+        EXPECT_FALSE(facet.IsFlag(MeshCore::MeshFacet::VISIT));
+    }
+}
+
+TEST(MeshTest, TestTopoAlgorithmBatch)
+{
+    MeshCore::MeshKernel kernel;
+    Base::Vector3f p1 {0, 0, 0};
+    Base::Vector3f p2 {1, 0, 0};
+    Base::Vector3f p3 {0, 1, 0};
+    Base::Vector3f p4 {1, 1, 0};
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+
+    MeshCore::MeshTopoAlgorithm topalg(kernel);
+    topalg.BeginBatch();
+    EXPECT_TRUE(topalg.SplitEdge(0, 1, Base::Vector3f(0.5F, 0.5F, 0.0F)));
+    topalg.EndBatch();
+
+    EXPECT_EQ(kernel.CountPoints(), 5);
+    EXPECT_EQ(kernel.CountFacets(), 4);
+    EXPECT_TRUE(MeshCore::MeshEvalNeighbourhood(kernel).Evaluate());
+}
+
+namespace
+{
+// A flat grid of 5 x 5 points and 32 facets
+MeshCore::MeshKernel createGrid()
+{
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            Base::Vector3f p1(float(i), float(j), 0);
+            Base::Vector3f p2(float(i + 1), float(j), 0);
+            Base::Vector3f p3(float(i), float(j + 1), 0);
+            Base::Vector3f p4(float(i + 1), float(j + 1), 0);
+            facets.emplace_back(p1, p2, p3);
+            facets.emplace_back(p3, p2, p4);
+        }
+    }
+    MeshCore::MeshKernel kernel;
+    kernel = facets;
+    return kernel;
+}
+
+// Returns the facet whose gravity point is closest to the given point
+MeshCore::FacetIndex findFacet(const MeshCore::MeshKernel& kernel, const Base::Vector3f& pnt)
+{
+    MeshCore::FacetIndex index = MeshCore::FACET_INDEX_MAX;
+    float dist = FLT_MAX;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        float d = Base::Distance(kernel.GetFacet(i).GetGravityPoint(), pnt);
+        if (d < dist) {
+            dist = d;
+            index = i;
+        }
+    }
+    return index;
+}
+}  // namespace
+
+TEST(MeshTest, TestTopoAlgorithmBatchCollapseFacet)
+{
+    MeshCore::MeshKernel kernel = createGrid();
+    MeshCore::FacetIndex facet = findFacet(kernel, Base::Vector3f(1.3F, 1.3F, 0));
+    MeshCore::FacetIndex far = findFacet(kernel, Base::Vector3f(3.7F, 3.7F, 0));
+    MeshCore::MeshFacet face = kernel.GetFacets()[facet];
+    ASSERT_EQ(face.CountOpenEdges(), 0);
+    Base::Vector3f moved = kernel.GetPoint(face._aulPoints[0]);
+    Base::Vector3f removed = kernel.GetPoint(face._aulPoints[1]);
+    Base::Vector3f center = kernel.GetFacet(facet).GetGravityPoint();
+
+    MeshCore::MeshTopoAlgorithm topalg(kernel);
+    topalg.BeginBatch();
+    EXPECT_TRUE(topalg.CollapseFacet(facet));
+
+    // the moved point is found at its new position only
+    EXPECT_FALSE(topalg.InsertVertex(far, center));
+
+    // the removed point and the old position of the moved point are new points
+    MeshCore::PointIndex numPoints = kernel.CountPoints();
+    EXPECT_TRUE(topalg.InsertVertex(far, removed));
+    EXPECT_EQ(kernel.GetFacets()[far]._aulPoints[2], numPoints);
+    EXPECT_TRUE(topalg.InsertVertex(far, moved));
+    EXPECT_EQ(kernel.GetFacets()[far]._aulPoints[2], numPoints + 1);
+    EXPECT_EQ(kernel.GetPoint(numPoints), removed);
+    EXPECT_EQ(kernel.GetPoint(numPoints + 1), moved);
+
+    // both points are found once they are added
+    EXPECT_FALSE(topalg.InsertVertex(far, removed));
+    EXPECT_FALSE(topalg.InsertVertex(far, moved));
+    topalg.EndBatch();
+
+    // the collapse removes the facet, its three neighbours and two points
+    EXPECT_EQ(kernel.CountFacets(), 32 - 4 + 4);
+    EXPECT_EQ(kernel.CountPoints(), 25 - 2 + 2);
+    EXPECT_TRUE(MeshCore::MeshEvalNeighbourhood(kernel).Evaluate());
+    EXPECT_TRUE(MeshCore::MeshEvalRangePoint(kernel).Evaluate());
+}
+
+TEST(MeshTest, TestTopoAlgorithmBatchCleanup)
+{
+    MeshCore::MeshKernel kernel = createGrid();
+    MeshCore::FacetIndex facet = findFacet(kernel, Base::Vector3f(1.3F, 1.3F, 0));
+    MeshCore::MeshFacet face = kernel.GetFacets()[facet];
+    Base::Vector3f removed = kernel.GetPoint(face._aulPoints[1]);
+
+    MeshCore::MeshTopoAlgorithm topalg(kernel);
+    topalg.BeginBatch();
+    EXPECT_TRUE(topalg.CollapseFacet(facet));
+    topalg.Cleanup();
+    MeshCore::PointIndex numPoints = kernel.CountPoints();
+    ASSERT_EQ(numPoints, 23);
+
+    // the points have been renumbered, so the last point of the grid has a new index
+    MeshCore::FacetIndex far = findFacet(kernel, Base::Vector3f(3.7F, 3.7F, 0));
+    EXPECT_FALSE(topalg.InsertVertex(far, Base::Vector3f(4, 4, 0)));
+
+    // the removed point is not in the mesh anymore
+    EXPECT_TRUE(topalg.InsertVertex(far, removed));
+    EXPECT_EQ(kernel.GetFacets()[far]._aulPoints[2], numPoints);
+    EXPECT_EQ(kernel.GetPoint(numPoints), removed);
+    topalg.EndBatch();
+
+    EXPECT_EQ(kernel.CountFacets(), 32 - 4 + 2);
+    EXPECT_EQ(kernel.CountPoints(), 24);
+    EXPECT_TRUE(MeshCore::MeshEvalNeighbourhood(kernel).Evaluate());
+    EXPECT_TRUE(MeshCore::MeshEvalRangePoint(kernel).Evaluate());
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
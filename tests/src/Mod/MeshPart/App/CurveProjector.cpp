@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/MeshPart/App/CurveProjector.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class CurveProjectorTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A strip of four unit squares along the x-axis, each split at the diagonal from
+        // (i, 0) to (i + 1, 1)
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        for (int i = 0; i < 4; i++) {
+            auto x = float(i);
+            facets.emplace_back(Base::Vector3f(x, 0, 0),
+                                Base::Vector3f(x + 1, 0, 0),
+                                Base::Vector3f(x + 1, 1, 0));
+            facets.emplace_back(Base::Vector3f(x, 0, 0),
+                                Base::Vector3f(x + 1, 1, 0),
+                                Base::Vector3f(x, 1, 0));
+        }
+        kernel = facets;
+    }
+
+    const MeshCore::MeshKernel& getKernel() const
+    {
+        return kernel;
+    }
+
+    // samples the line y = 0.5 in the range [0.2, 3.8]
+    static std::vector<Base::Vector3f> sampleLine(int numPoints)
+    {
+        std::vector<Base::Vector3f> points;
+        for (int i = 0; i < numPoints; i++) {
+            float x = 0.2F + 3.6F * float(i) / float(numPoints - 1);
+            points.emplace_back(x, 0.5F, 0.1F);
+        }
+        return points;
+    }
+
+    // checks that the path crosses all diagonals and inner edges of the strip
+    static void checkPath(const MeshPart::CurveProjectorBatch::Path& path, float minX, float maxX)
+    {
+        std::vector<float> crossings;
+        for (float x : {0.5F, 1.0F, 1.5F, 2.0F, 2.5F, 3.0F, 3.5F}) {
+            if (x > minX && x < maxX) {
+                crossings.push_back(x);
+            }
+        }
+
+        ASSERT_EQ(path.size(), crossings.size() + 1);
+        for (std::size_t i = 0; i < path.size(); i++) {
+            EXPECT_NEAR(path[i].p1.y, 0.5F, 1e-5F);
+            EXPECT_NEAR(path[i].p2.y, 0.5F, 1e-5F);
+            EXPECT_FLOAT_EQ(path[i].p1.z, 0.0F);
+            if (i > 0) {
+                // consecutive segments meet on an edge of the mesh
+                EXPECT_EQ(path[i - 1].p2, path[i].p1);
+                EXPECT_NE(path[i - 1].ulFaceIndex, path[i].ulFaceIndex);
+                EXPECT_NEAR(path[i].p1.x, crossings[i - 1], 1e-5F);
+            }
+        }
+        EXPECT_NEAR(path.front().p1.x, minX, 1e-5F);
+        EXPECT_NEAR(path.back().p2.x, maxX, 1e-5F);
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(CurveProjectorTest, testAdjacentFacets)
+{
+    std::vector<std::vector<Base::Vector3f>> curves {sampleLine(100)};
+    MeshPart::CurveProjectorBatch projector(getKernel());
+    auto paths = projector.project(curves, 1.0F);
+    ASSERT_EQ(paths.size(), 1);
+    ASSERT_EQ(paths[0].size(), 1);
+    checkPath(paths[0][0], 0.2F, 3.8F);
+}
+
+TEST_F(CurveProjectorTest, testBisection)
+{
+    // the two samples lie on facets without a common edge
+    std::vector<std::vector<Base::Vector3f>> curves {sampleLine(2)};
+    MeshPart::CurveProjectorBatch projector(getKernel());
+    auto paths = projector.project(curves, 1.0F);
+    ASSERT_EQ(paths.size(), 1);
+    ASSERT_EQ(paths[0].size(), 1);
+    checkPath(paths[0][0], 0.2F, 3.8F);
+}
+
+TEST_F(CurveProjectorTest, testGap)
+{
+    // a sample too far away from the mesh interrupts the path
+    std::vector<Base::Vector3f> points = sampleLine(19);
+    points[9].z = 5.0F;
+
+    std::vector<std::vector<Base::Vector3f>> curves {points};
+    MeshPart::CurveProjectorBatch projector(getKernel());
+    auto paths = projector.project(curves, 1.0F);
+    ASSERT_EQ(paths.size(), 1);
+    ASSERT_EQ(paths[0].size(), 2);
+    checkPath(paths[0][0], 0.2F, points[8].x);
+    checkPath(paths[0][1], points[10].x, 3.8F);
+}
+
+TEST_F(CurveProjectorTest, testOutsideMesh)
+{
+    std::vector<Base::Vector3f> points = sampleLine(10);
+    for (auto& it : points) {
+        it.z = 5.0F;
+    }
+
+    std::vector<std::vector<Base::Vector3f>> curves {points, {}};
+    MeshPart::CurveProjectorBatch projector(getKernel());
+    auto paths = projector.project(curves, 1.0F);
+    ASSERT_EQ(paths.size(), 2);
+    EXPECT_TRUE(paths[0].empty());
+    EXPECT_TRUE(paths[1].empty());
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
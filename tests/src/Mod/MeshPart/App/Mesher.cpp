@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <gp_Trsf.hxx>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/MeshPart/App/Mesher.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class MesherTest: public ::testing::Test
+{
+protected:
+    static std::vector<Mesh::MeshObject*>
+    createMeshes(const std::vector<TopoDS_Shape>& shapes,
+                 std::vector<MeshPart::Mesher::FaceTiming>& timings)
+    {
+        return MeshPart::Mesher::createMeshes(shapes, 0.1, 0.5, false, false, timings);
+    }
+    static void deleteMeshes(std::vector<Mesh::MeshObject*>& meshes)
+    {
+        for (auto it : meshes) {
+            delete it;
+        }
+        meshes.clear();
+    }
+};
+
+TEST_F(MesherTest, testBox)
+{
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+    std::vector<MeshPart::Mesher::FaceTiming> timings;
+    std::vector<Mesh::MeshObject*> meshes = createMeshes({box}, timings);
+
+    ASSERT_EQ(meshes.size(), 1);
+    EXPECT_EQ(meshes[0]->countFacets(), 12);
+    EXPECT_TRUE(meshes[0]->isSolid());
+
+    ASSERT_EQ(timings.size(), 6);
+    for (std::size_t i = 0; i < timings.size(); i++) {
+        EXPECT_EQ(timings[i].shape, 0);
+        EXPECT_EQ(timings[i].face, i + 1);
+        EXPECT_EQ(timings[i].facets, 2);
+    }
+
+    deleteMeshes(meshes);
+}
+
+TEST_F(MesherTest, testSharedEdges)
+{
+    // The faces of the cylinder share edges, so the mesh of the solid is only closed if every
+    // face reuses the discretization of the edges meshed for its neighbours
+    TopoDS_Shape cylinder = BRepPrimAPI_MakeCylinder(5.0, 10.0).Shape();
+    std::vector<TopoDS_Shape> shapes {cylinder};
+    for (TopExp_Explorer xp(cylinder, TopAbs_FACE); xp.More(); xp.Next()) {
+        shapes.push_back(xp.Current());
+    }
+
+    std::vector<MeshPart::Mesher::FaceTiming> timings;
+    std::vector<Mesh::MeshObject*> meshes = createMeshes(shapes, timings);
+    ASSERT_EQ(meshes.size(), 4);
+    EXPECT_TRUE(meshes[0]->isSolid());
+
+    // every face is meshed once only and is counted for the first shape it belongs to
+    ASSERT_EQ(timings.size(), 3);
+    unsigned long numFacets = 0;
+    for (const auto& it : timings) {
+        EXPECT_EQ(it.shape, 0);
+        numFacets += it.facets;
+    }
+    EXPECT_EQ(meshes[0]->countFacets(), numFacets);
+    EXPECT_EQ(meshes[1]->countFacets() + meshes[2]->countFacets() + meshes[3]->countFacets(),
+              numFacets);
+
+    deleteMeshes(meshes);
+}
+
+TEST_F(MesherTest, testLinkedCopies)
+{
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(20.0, 0.0, 0.0));
+    TopoDS_Shape copy = box.Moved(TopLoc_Location(trsf));
+
+    std::vector<MeshPart::Mesher::FaceTiming> timings;
+    std::vector<Mesh::MeshObject*> meshes = createMeshes({box, copy, TopoDS_Shape()}, timings);
+    ASSERT_EQ(meshes.size(), 3);
+    EXPECT_EQ(timings.size(), 6);
+
+    EXPECT_EQ(meshes[0]->countFacets(), 12);
+    EXPECT_EQ(meshes[1]->countFacets(), 12);
+    EXPECT_DOUBLE_EQ(meshes[1]->getBoundBox().MinX, 20.0);
+    EXPECT_EQ(meshes[2]->countFacets(), 0);
+
+    deleteMeshes(meshes);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -2,7 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 #include <BRepFilletAPI_MakeFillet.hxx>
+#include <Base/Reader.h>
+#include <Base/Writer.h>
 #include "Mod/Part/App/FeaturePartCommon.h"
 #include "Mod/Part/App/PropertyTopoShape.h"
 #include <src/App/InitApplication.h>
@@ -269,3 +273,27 @@ TEST_F(PropertyTopoShapeTest, testRestore)
     EXPECT_TRUE(reader.isValid());
     EXPECT_TRUE(reader.isEndOfElement());
 }
+
+TEST_F(PropertyTopoShapeTest, testBinaryChecksumRoundTrip)
+{
+    // Arrange
+    Part::PropertyPartShape prop;
+    prop.setValue(_boxes[0]->Shape.getShape());
+    Base::StringWriter writer;
+    writer.setMode("BinaryBrep");
+    prop.SaveDocFile(writer);
+    std::string data = writer.getString();
+    std::string corrupted = data;
+    corrupted.back() = static_cast<char>(corrupted.back() ^ 0x01);  // Last byte of the CRC
+    std::stringstream validStream(data);
+    std::stringstream corruptedStream(corrupted);
+    Base::Reader validReader(validStream, "PartShape.bin", 1);
+    Base::Reader corruptedReader(corruptedStream, "PartShape.bin", 1);
+    Part::PropertyPartShape valid;
+    Part::PropertyPartShape restored;
+    // Act / Assert
+    EXPECT_NO_THROW(valid.RestoreDocFile(validReader));
+    EXPECT_THROW(restored.RestoreDocFile(corruptedReader), Base::RestoreError);
+    EXPECT_EQ(getVolume(valid.getValue()), 6);
+    EXPECT_EQ(getVolume(restored.getValue()), 6);  // The shape itself is still restored
+}
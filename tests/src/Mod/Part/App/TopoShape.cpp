@@ -5,6 +5,11 @@
 #include <Mod/Part/App/TopoShape.h>
 #include "src/App/InitApplication.h"
 
+#include <sstream>
+#include <BRep_Tool.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <TopoDS.hxx>
+
 
 class TopoShapeTest: public ::testing::Test
 {
@@ -136,4 +141,28 @@ TEST_F(TopoShapeTest, TestGetSubshape)
     EXPECT_THROW(cube1.getSubShape("WOOHOO", false), Base::ValueError);  // Invalid
 }
 
+TEST_F(TopoShapeTest, TestExportBinaryWithTriangles)
+{
+    // Arrange
+    auto [cube1, cube2] = PartTestHelpers::CreateTwoCubes();
+    BRepMesh_IncrementalMesh(cube1, 0.1);
+    Part::TopoShape shape {cube1};
+    std::stringstream withTriangles;
+    std::stringstream withoutTriangles;
+    // Act
+    shape.exportBinary(withTriangles, true);
+    shape.exportBinary(withoutTriangles);
+    Part::TopoShape restored;
+    restored.importBinary(withTriangles);
+    Part::TopoShape restoredPlain;
+    restoredPlain.importBinary(withoutTriangles);
+    // Assert
+    TopLoc_Location loc;
+    auto face = TopoDS::Face(restored.getSubShape("Face1"));
+    EXPECT_FALSE(BRep_Tool::Triangulation(face, loc).IsNull());
+    auto plainFace = TopoDS::Face(restoredPlain.getSubShape("Face1"));
+    EXPECT_TRUE(BRep_Tool::Triangulation(plainFace, loc).IsNull());
+    EXPECT_EQ(restored.countSubShapes(TopAbs_FACE), 6);
+}
+
 // clang-format on
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/Part/App/TopoShapeCache.h>
@@ -11,6 +12,9 @@
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepAlgoAPI_Fuse.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepBndLib.hxx>
+#include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
 #include <TopoDS_Edge.hxx>
 
 // NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -281,4 +285,74 @@ TEST_F(TopoShapeCacheTest, FindAncestor)
     EXPECT_FALSE(ancestorResultCompound.IsNull());
 }
 
+TEST_F(TopoShapeCacheTest, FindShapesInBox)
+{
+    // Arrange
+    auto shape = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    Part::TopoShapeCache cache(shape);
+    Bnd_Box box;
+    box.Add(gp_Pnt(1.0, 1.0, 1.0));
+    box.Enlarge(0.1);
+
+    // Act
+    auto vertices = cache.findShapesInBox(shape, TopAbs_VERTEX, box);
+    auto edges = cache.findShapesInBox(shape, TopAbs_EDGE, box);
+    auto faces = cache.findShapesInBox(shape, TopAbs_FACE, box);
+
+    // Assert
+    ASSERT_EQ(1, vertices.size());
+    EXPECT_TRUE(BRep_Tool::Pnt(TopoDS::Vertex(cache.findShape(shape, TopAbs_VERTEX, vertices[0])))
+                    .IsEqual(gp_Pnt(1.0, 1.0, 1.0), Precision::Confusion()));
+    EXPECT_EQ(3, edges.size());
+    EXPECT_EQ(3, faces.size());
+    EXPECT_TRUE(std::is_sorted(faces.begin(), faces.end()));
+}
+
+TEST_F(TopoShapeCacheTest, FindShapesInBoxWithLocation)
+{
+    // Arrange
+    auto shape = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    gp_Trsf transform;
+    transform.SetTranslation(gp_Vec(10.0, 0.0, 0.0));
+    shape.Location(TopLoc_Location(transform));
+    Part::TopoShapeCache cache(shape);
+    Bnd_Box box;
+    box.Add(gp_Pnt(10.0, 0.0, 0.0));
+    box.Enlarge(0.1);
+    Bnd_Box unlocatedBox;
+    unlocatedBox.Add(gp_Pnt(-1.0, 0.0, 0.0));
+    unlocatedBox.Enlarge(0.1);
+
+    // Act
+    auto vertices = cache.findShapesInBox(shape, TopAbs_VERTEX, box);
+    auto none = cache.findShapesInBox(shape, TopAbs_VERTEX, unlocatedBox);
+
+    // Assert
+    ASSERT_EQ(1, vertices.size());
+    EXPECT_TRUE(BRep_Tool::Pnt(TopoDS::Vertex(cache.findShape(shape, TopAbs_VERTEX, vertices[0])))
+                    .IsEqual(gp_Pnt(10.0, 0.0, 0.0), Precision::Confusion()));
+    EXPECT_TRUE(none.empty());
+}
+
+TEST_F(TopoShapeCacheTest, FindNearestShapes)
+{
+    // Arrange
+    auto shape = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    Part::TopoShapeCache cache(shape);
+
+    // Act
+    auto faces = cache.findNearestShapes(shape, TopAbs_FACE, gp_Pnt(0.5, 0.5, -2.0));
+    auto vertices = cache.findNearestShapes(shape, TopAbs_VERTEX, gp_Pnt(0.0, 0.0, -2.0), 8);
+
+    // Assert
+    ASSERT_EQ(1, faces.size());
+    auto face = cache.findShape(shape, TopAbs_FACE, faces[0]);
+    Bnd_Box faceBox;
+    BRepBndLib::Add(face, faceBox);
+    EXPECT_NEAR(0.0, faceBox.CornerMax().Z(), 1e-6);
+    ASSERT_EQ(8, vertices.size());
+    EXPECT_TRUE(BRep_Tool::Pnt(TopoDS::Vertex(cache.findShape(shape, TopAbs_VERTEX, vertices[0])))
+                    .IsEqual(gp_Pnt(0.0, 0.0, 0.0), Precision::Confusion()));
+}
+
 // NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -2420,6 +2420,24 @@ TEST_F(TopoShapeExpansionTest, makeElementSlices)
                                                     // again after importing other TopoNaming logics
 }
 
+TEST_F(TopoShapeExpansionTest, makeElementSlicesOutsideShape)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1, 1L};
+    Base::Vector3d direction {1.0, 0.0, 0.0};
+    // Act
+    TopoShape result;
+    result.makeElementSlices(cube1TS, direction, {-1.0, 0.5, 2.0});
+    // Assert only the plane crossing the cube gives a wire
+    EXPECT_EQ(result.countSubElements("Wire"), 1);
+    EXPECT_FLOAT_EQ(getLength(result.getShape()), 4);
+    // Assert the result matches the same planes sliced by the plain cross section
+    TopoShape plain {cube1TS.slices(direction, {-1.0, 0.5, 2.0})};
+    EXPECT_EQ(plain.countSubElements("Wire"), 1);
+    EXPECT_FLOAT_EQ(getLength(plain.getShape()), 4);
+}
+
 TEST_F(TopoShapeExpansionTest, makeElementMirror)
 {
     // Arrange
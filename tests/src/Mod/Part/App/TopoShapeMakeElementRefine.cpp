@@ -53,3 +53,22 @@ TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineBoxes)
     // TODO: Refine doesn't work on compounds, so we're going to need a binary operation or the
     // like, and those don't exist yet.  Once they do, this test can be expanded
 }
+
+TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineRowOfBoxes)
+{
+    // Arrange
+    const int count = 20;
+    std::vector<Part::TopoShape> boxes;
+    for (int i = 0; i < count; ++i) {
+        boxes.emplace_back(BRepPrimAPI_MakeBox(gp_Pnt(i, 0.0, 0.0), 1.0, 1.0, 1.0).Shape());
+    }
+    // Act
+    Part::TopoShape ts;
+    ts.makeElementFuse(boxes);
+    Part::TopoShape refined = ts.makeElementRefine();
+    // Assert
+    EXPECT_NEAR(PartTestHelpers::getVolume(refined.getShape()), count, 1e-6);
+    EXPECT_EQ(ts.countSubElements("Face"), 4 * count + 2);  // Each box adds 4 side faces
+    EXPECT_EQ(refined.countSubElements("Face"), 6);         // After refining it is one box
+    EXPECT_EQ(refined.countSubElements("Edge"), 12);
+}
@@ -382,6 +382,36 @@ TEST_F(WireJoinerTest, setSplitEdges)
     EXPECT_EQ(wireSplitEdges.getSubTopoShapes(TopAbs_EDGE).size(), 4);
 }
 
+TEST_F(WireJoinerTest, setSplitEdgesTouching)
+{
+    // Arrange
+
+    // Create a T junction, where one edge ends on the other one, and a third edge that passes
+    // close to the first one without touching it
+
+    auto edge1 {BRepBuilderAPI_MakeEdge(gp_Pnt(0.0, 0.0, 0.0), gp_Pnt(2.0, 0.0, 0.0)).Edge()};
+    auto edge2 {BRepBuilderAPI_MakeEdge(gp_Pnt(1.0, 0.0, 0.0), gp_Pnt(1.0, 1.0, 0.0)).Edge()};
+    auto edge3 {BRepBuilderAPI_MakeEdge(gp_Pnt(1.5, 0.1, 0.0), gp_Pnt(1.5, 1.0, 0.0)).Edge()};
+
+    std::vector<TopoDS_Shape> edges {edge1, edge2, edge3};
+
+    auto wjSplitEdges {WireJoiner()};
+    wjSplitEdges.setTightBound(false);
+    auto wireSplitEdges {TopoShape(1)};
+
+    // Act
+
+    wjSplitEdges.addShape(edges);
+    wjSplitEdges.setSplitEdges();
+    wjSplitEdges.Build();
+    wjSplitEdges.getOpenWires(wireSplitEdges, nullptr, false);
+
+    // Assert
+
+    // Only edge1 is split, at the end point of edge2
+    EXPECT_EQ(wireSplitEdges.getSubTopoShapes(TopAbs_EDGE).size(), 4);
+}
+
 TEST_F(WireJoinerTest, setMergeEdges)
 {
     // Arrange
@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
 #include <Base/FileInfo.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
+#include <Mod/Points/App/PointsOctree.h>
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
 
@@ -138,6 +143,34 @@ TEST_F(PointsTest, TestASCII)
     EXPECT_EQ(reader.getHeight(), 1);
 }
 
+TEST_F(PointsTest, TestLoadASCII)
+{
+    // The file is larger than a chunk, so it is parsed in parallel. Comments, blank lines and
+    // lines with more than three numbers are no points.
+    std::string name = getFileName() + ".asc";
+    const int numPoints = 200000;
+    {
+        std::ofstream str(name);
+        str << "# x y z\n";
+        for (int i = 0; i < numPoints; i++) {
+            str << i << " 1 2\n";
+            if (i % 1000 == 0) {
+                str << "\n# comment\n1 2 3 4\n";
+            }
+        }
+    }
+
+    // the file replaces the points of the kernel
+    Points::PointKernel kernel(20);
+    Points::PointsAlgos::Load(kernel, name.c_str());
+    Base::FileInfo(name).deleteFile();
+
+    ASSERT_EQ(kernel.size(), numPoints);
+    for (int i = 0; i < numPoints; i++) {
+        ASSERT_EQ(kernel.getPoint(i), Base::Vector3d(i, 1, 2));
+    }
+}
+
 TEST_F(PointsTest, TestPlainPLY)
 {
     std::string name = getFileName();
@@ -238,4 +271,99 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestPLYValues)
+{
+    std::string name = getFileName();
+    Points::PlyWriter writer(getKernel());
+    writer.setIntensities(getIntensity());
+    writer.setNormals(getNormals());
+    writer.write(name);
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    const Points::PointKernel& points = reader.getPoints();
+    ASSERT_EQ(points.size(), getKernel().size());
+    ASSERT_EQ(reader.getIntensities().size(), points.size());
+    ASSERT_EQ(reader.getNormals().size(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(points.getPoint(i), getKernel().getPoint(i));
+        EXPECT_FLOAT_EQ(reader.getIntensities()[i], getIntensity()[i]);
+        EXPECT_EQ(reader.getNormals()[i], getNormals()[i]);
+    }
+}
+
+TEST_F(PointsTest, TestOctree)
+{
+    Points::PointsOctree octree(getKernel(), 1);
+    EXPECT_EQ(octree.GetIndices().size(), getKernel().size());
+
+    std::vector<unsigned long> indices;
+    octree.Inside(Base::BoundBox3d(-0.5, -0.5, -0.5, 0.5, 1.5, 1.5), indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(indices, std::vector<unsigned long>({0, 1, 2, 3}));
+
+    std::vector<unsigned long> lod = octree.GetLevelOfDetail(2);
+    ASSERT_EQ(lod.size(), 2);
+    EXPECT_NE(lod[0], lod[1]);
+    EXPECT_EQ(octree.GetLevelOfDetail(100).size(), getKernel().size());
+}
+
+TEST_F(PointsTest, TestOctreeLevelOfDetail)
+{
+    // A regular grid of 32 x 32 x 32 points and an invalid point
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < 32; i++) {
+        for (int j = 0; j < 32; j++) {
+            for (int k = 0; k < 32; k++) {
+                points.emplace_back(float(i), float(j), float(k));
+            }
+        }
+    }
+    points.emplace_back(std::numeric_limits<float>::quiet_NaN(), 0, 0);
+    Points::PointKernel grid;
+    grid.setBasicPoints(points);
+
+    Points::PointsOctree octree(grid, 64);
+    EXPECT_EQ(octree.GetIndices().size(), points.size() - 1);
+
+    std::vector<unsigned long> lod = octree.GetLevelOfDetail(4096);
+    ASSERT_EQ(lod.size(), 4096);
+    std::sort(lod.begin(), lod.end());
+    EXPECT_EQ(std::unique(lod.begin(), lod.end()), lod.end());
+    EXPECT_LT(lod.back(), points.size() - 1);
+
+    // The subset must cover the whole cloud evenly, so every octant gets an eighth of the points
+    std::array<int, 8> octants {};
+    for (unsigned long index : lod) {
+        const Base::Vector3f& pnt = points[index];
+        int octant = (pnt.x >= 16 ? 1 : 0) + (pnt.y >= 16 ? 2 : 0) + (pnt.z >= 16 ? 4 : 0);
+        octants[octant]++;
+    }
+    for (int count : octants) {
+        EXPECT_EQ(count, 512);
+    }
+}
+
+TEST_F(PointsTest, TestOctreeNeighbours)
+{
+    Points::PointsOctree octree(getKernel(), 1);
+    std::vector<Base::Vector3f> pnts {Base::Vector3f(0.1F, 0, 0), Base::Vector3f(1, 1, 1.2F)};
+
+    std::vector<unsigned long> indices;
+    std::vector<float> distances;
+    ASSERT_EQ(octree.NearestNeighbours(pnts, 2, indices, distances), 2);
+    ASSERT_EQ(indices.size(), 4);
+    EXPECT_EQ(indices[0], 0);
+    EXPECT_NEAR(distances[0], 0.1F, 1e-6F);
+    EXPECT_EQ(indices[2], 7);
+    EXPECT_NEAR(distances[2], 0.2F, 1e-6F);
+    EXPECT_LE(distances[2], distances[3]);
+
+    std::vector<std::size_t> offsets;
+    octree.Within(pnts, 1.0F, offsets, indices, distances);
+    EXPECT_EQ(offsets, std::vector<std::size_t>({0, 2, 3}));
+    EXPECT_EQ(indices[2], 7);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)